@@ -0,0 +1,335 @@
+#include "BatchSimulator.h"
+#include "BotInterface.h"
+#include "Game.h"
+#include "Policies.h"
+using namespace monopoly;
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace
+{
+    template <typename T>
+    void write_value(std::ostream& out, T value) {
+        out.write(reinterpret_cast<char const*> (&value), sizeof(value));
+    }
+
+    template <typename T>
+    T read_value(std::istream& in) {
+        T value{};
+        in.read(reinterpret_cast<char*> (&value), sizeof(value));
+        return value;
+    }
+}
+
+void SimulationResults::merge(SimulationResults const& other) {
+    statistics.merge(other.statistics);
+    gamesPlayed += other.gamesPlayed;
+    adjudicatedGames += other.adjudicatedGames;
+    wallTimeGames += other.wallTimeGames;
+    turnsPlayed += other.turnsPlayed;
+    for (auto seat = 0; seat < static_cast<int> (winsBySeat.size()); ++seat) {
+        winsBySeat[seat] += other.winsBySeat[seat];
+    }
+}
+
+CompletedGames::CompletedGames(int watermark, std::set<int> above)
+    : watermark(watermark)
+    , above(std::move(above))
+{
+}
+
+void CompletedGames::add(int gameIndex) {
+    if (gameIndex < watermark) {
+        return;
+    }
+    above.insert(gameIndex);
+    while (!above.empty() && *above.begin() == watermark) {
+        above.erase(above.begin());
+        ++watermark;
+    }
+}
+
+bool CompletedGames::contains(int gameIndex) const {
+    return gameIndex < watermark || above.count(gameIndex) > 0;
+}
+
+void SimulationCheckpoint::save(std::string const& path) const {
+    auto const temporaryPath = path + ".tmp";
+    {
+        std::ofstream out(temporaryPath, std::ios::binary | std::ios::trunc);
+        out.write(Magic, sizeof(Magic));
+        write_value(out, Version);
+        write_value(out, static_cast<uint32_t> (settings.size()));
+        out.write(settings.data(), settings.size());
+        write_value(out, static_cast<int32_t> (completed.get_watermark()));
+        write_value(out, static_cast<uint32_t> (completed.get_above().size()));
+        for (auto gameIndex : completed.get_above()) {
+            write_value(out, static_cast<int32_t> (gameIndex));
+        }
+        write_value(out, static_cast<int32_t> (results.gamesPlayed));
+        write_value(out, static_cast<int32_t> (results.adjudicatedGames));
+        write_value(out, static_cast<int32_t> (results.wallTimeGames));
+        write_value(out, static_cast<int64_t> (results.turnsPlayed));
+        write_value(out, results.seconds);
+        write_value(out, static_cast<uint32_t> (results.winsBySeat.size()));
+        for (auto wins : results.winsBySeat) {
+            write_value(out, static_cast<int32_t> (wins));
+        }
+        results.statistics.write(out);
+        out.flush();
+        if (!out) {
+            throw std::runtime_error("Unable to write checkpoint \"" + temporaryPath + "\"");
+        }
+    }
+    std::filesystem::rename(temporaryPath, path);
+}
+
+bool SimulationCheckpoint::load(std::string const& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+    auto const unreadable = std::runtime_error("\"" + path + "\" is not a simulation checkpoint");
+    char magic[sizeof(Magic)];
+    in.read(magic, sizeof(magic));
+    auto const version = read_value<uint32_t>(in);
+    if (!in || !std::equal(std::begin(magic), std::end(magic), std::begin(Magic)) || version != Version) {
+        throw unreadable;
+    }
+    settings.assign(read_value<uint32_t>(in), '\0');
+    in.read(&settings[0], settings.size());
+    auto const watermark = read_value<int32_t>(in);
+    std::set<int> above;
+    for (auto count = read_value<uint32_t>(in); in && count > 0; --count) {
+        above.insert(read_value<int32_t>(in));
+    }
+    completed = CompletedGames(watermark, std::move(above));
+    results.gamesPlayed = read_value<int32_t>(in);
+    results.adjudicatedGames = read_value<int32_t>(in);
+    results.wallTimeGames = read_value<int32_t>(in);
+    results.turnsPlayed = read_value<int64_t>(in);
+    results.seconds = read_value<double>(in);
+    results.winsBySeat.assign(read_value<uint32_t>(in), 0);
+    for (auto& wins : results.winsBySeat) {
+        wins = read_value<int32_t>(in);
+    }
+    if (!in) {
+        throw unreadable;
+    }
+    results.statistics.read(in);
+    return true;
+}
+
+BatchSimulator::BatchSimulator(SimulationOptions options)
+    : options(std::move(options))
+    , auctionBidder(this->options.equityAuctions ? std::make_shared<AuctionBidder const>() : nullptr)
+{
+    for (auto seat = 0; seat < this->options.playerCount; ++seat) {
+        if (!make_policy(seat_policy_name(seat))) {
+            throw std::invalid_argument("Unknown policy \"" + seat_policy_name(seat) + "\"");
+        }
+    }
+    if (!this->options.checkpointPath.empty() && !this->options.recordDirectory.empty()) {
+        throw std::invalid_argument("Checkpoints can't be used while recording, shards are written in a single pass");
+    }
+}
+
+std::string const& BatchSimulator::seat_policy_name(int seat) const {
+    auto const& policies = options.policies;
+    return policies[std::min<size_t>(seat, policies.size() - 1)];
+}
+
+SimulationResults BatchSimulator::run() const {
+    auto const threadCount = std::max(1, options.threadCount);
+    std::vector<SimulationResults> threadResults(threadCount, empty_results());
+    auto const writers = open_shards();
+
+    auto const checkpointing = !options.checkpointPath.empty();
+    Progress progress;
+    progress.checkpoint.settings = settings();
+    progress.checkpoint.results = empty_results();
+    if (checkpointing && progress.checkpoint.load(options.checkpointPath) && progress.checkpoint.settings != settings()) {
+        throw std::invalid_argument("Checkpoint \"" + options.checkpointPath + "\" was saved with different options");
+    }
+    auto const resumed = progress.checkpoint.completed;
+    std::atomic<int> nextGameIndex{ resumed.get_watermark() };
+
+    progress.start = std::chrono::steady_clock::now();
+    progress.nextSave = progress.start + options.checkpointInterval;
+    std::vector<std::thread> workers;
+    for (auto t = 0; t < threadCount; ++t) {
+        workers.emplace_back([this, checkpointing, &resumed, &progress, &nextGameIndex, &writers, &results = threadResults[t]]() {
+            for (auto gameIndex = nextGameIndex++; gameIndex < options.gameCount && !progress.failed; gameIndex = nextGameIndex++) {
+                if (resumed.contains(gameIndex)) {
+                    continue;
+                }
+                play_game(gameIndex, writers, results);
+                if (checkpointing) {
+                    complete_game(gameIndex, results, progress);
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    if (!progress.error.empty()) {
+        throw std::runtime_error(progress.error);
+    }
+    if (checkpointing) {
+        save_checkpoint(progress);
+    }
+    auto results = progress.checkpoint.results;
+    for (auto const& writer : writers) {
+        writer->finish();
+        results.recordsWritten += static_cast<long long> (writer->get_record_count());
+    }
+    auto const elapsed = std::chrono::steady_clock::now() - progress.start;
+
+    for (auto const& r : threadResults) {
+        results.merge(r);
+    }
+    results.seconds += std::chrono::duration<double>(elapsed).count();
+    return results;
+}
+
+GameSetup BatchSimulator::game_setup(int gameIndex) const {
+    GameSetup setup;
+    setup.seed = options.seed + ":" + std::to_string(gameIndex);
+    setup.playerCount = options.playerCount;
+    setup.rng = options.rng;
+    setup.maxTurns = options.maxTurns;
+    setup.maxWallTime = options.maxWallTime;
+    return setup;
+}
+
+std::string BatchSimulator::settings() const {
+    std::ostringstream out;
+    out << "seed=" << options.seed
+        << ";rng=" << static_cast<int> (options.rng)
+        << ";players=" << options.playerCount
+        << ";maxTurns=" << options.maxTurns
+        << ";maxWallTime=" << options.maxWallTime.count()
+        << ";equityAuctions=" << options.equityAuctions
+        << ";statistics=" << options.collectStatistics
+        << ";policies=";
+    for (auto seat = 0; seat < options.playerCount; ++seat) {
+        out << seat_policy_name(seat) << ",";
+    }
+    return out.str();
+}
+
+std::string BatchSimulator::shard_path(int shard) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "shard-%05d.bin", shard);
+    return options.recordDirectory + "/" + name;
+}
+
+void BatchSimulator::complete_game(int gameIndex, SimulationResults& results, Progress& progress) const {
+    auto saveDue = false;
+    {
+        std::lock_guard<std::mutex> lock(progress.mutex);
+        progress.checkpoint.results.merge(results);
+        progress.checkpoint.completed.add(gameIndex);
+        auto const now = std::chrono::steady_clock::now();
+        if (now >= progress.nextSave) {
+            progress.nextSave = now + options.checkpointInterval;
+            saveDue = true;
+        }
+    }
+    results = empty_results();
+    if (saveDue) {
+        try {
+            save_checkpoint(progress);
+        }
+        catch (std::exception const& e) {
+            std::lock_guard<std::mutex> lock(progress.saveMutex);
+            progress.error = e.what();
+            progress.failed = true;
+        }
+    }
+}
+
+void BatchSimulator::save_checkpoint(Progress& progress) const {
+    // Snapshots are taken and saved in turn, so a checkpoint is never replaced by an older one
+    std::lock_guard<std::mutex> saving(progress.saveMutex);
+    SimulationCheckpoint snapshot;
+    {
+        std::lock_guard<std::mutex> lock(progress.mutex);
+        snapshot = progress.checkpoint;
+    }
+    snapshot.results.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - progress.start).count();
+    snapshot.save(options.checkpointPath);
+}
+
+std::vector<std::unique_ptr<ShardWriter>> BatchSimulator::open_shards() const {
+    std::vector<std::unique_ptr<ShardWriter>> writers;
+    if (!options.recordDirectory.empty()) {
+        auto const shardCount = std::max(1, options.shardCount);
+        for (auto shard = 0; shard < shardCount; ++shard) {
+            writers.push_back(std::make_unique<ShardWriter>(shard_path(shard), shard, shardCount, options.gameCount));
+        }
+    }
+    return writers;
+}
+
+SimulationResults BatchSimulator::empty_results() const {
+    SimulationResults results;
+    results.winsBySeat.assign(options.playerCount, 0);
+    return results;
+}
+
+void BatchSimulator::play_game(int gameIndex, std::vector<std::unique_ptr<ShardWriter>> const& writers, SimulationResults& results) const {
+    GameRecorder recorder(gameIndex);
+    auto setup = game_setup(gameIndex);
+    std::vector<std::unique_ptr<IPolicy>> policies;
+    for (auto seat = 0; seat < options.playerCount; ++seat) {
+        auto policy = make_policy(seat_policy_name(seat), policy_seed(setup.seed, seat));
+        if (!writers.empty()) {
+            policy = std::make_unique<RecordingPolicy>(std::move(policy), recorder);
+        }
+        policies.push_back(std::move(policy));
+    }
+    StatisticsSink statisticsSink(results.statistics);
+    if (options.collectStatistics) {
+        setup.eventSink = &statisticsSink;
+    }
+    BotInterface interface(setup, std::move(policies));
+    interface.set_auction_bidder(auctionBidder);
+    Game game(&interface);
+
+    auto const& state = game.get_state();
+    while (!state.is_game_over()) {
+        game.process();
+    }
+
+    if (!writers.empty()) {
+        recorder.finish(state);
+        writers[gameIndex % writers.size()]->submit(gameIndex, recorder.take());
+    }
+
+    if (options.collectStatistics) {
+        statisticsSink.finish_game(state);
+    }
+
+    results.gamesPlayed += 1;
+    results.turnsPlayed += state.get_turn();
+    if (state.get_adjudication() != Adjudication::None) {
+        results.adjudicatedGames += 1;
+    }
+    if (state.get_adjudication() == Adjudication::WallTime) {
+        results.wallTimeGames += 1;
+    }
+    for (auto seat = 0; seat < options.playerCount; ++seat) {
+        if (!state.get_player_eliminated(seat)) {
+            results.winsBySeat[seat] += 1;
+        }
+    }
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "Bidding.h"
+#include "SelfPlay.h"
+#include "Statistics.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace monopoly
+{
+    struct SimulationOptions
+    {
+        std::string seed = "monopoly";
+        RngKind rng = RngKind::Mt19937;
+        int playerCount = 4;
+        int gameCount = 1000;
+        int threadCount = 1;
+        // Passed on as GameSetup::maxTurns and maxWallTime
+        int maxTurns = 1000;
+        std::chrono::milliseconds maxWallTime{ 0 };
+        // Policy name for each seat, the last name is repeated for any remaining seats
+        std::vector<std::string> policies = { "greedy" };
+        // Settle every auction at once with the equity table bidder instead of asking the seat policies for bids
+        bool equityAuctions = false;
+        // When set, every policy decision is recorded as training data in shardCount files in this directory
+        std::string recordDirectory;
+        int shardCount = 1;
+        // Collect GameStatistics from the events of every game
+        bool collectStatistics = false;
+        // When set, progress is saved to this file every checkpointInterval, and a run started with the file
+        // already there picks up where it left off
+        std::string checkpointPath;
+        std::chrono::seconds checkpointInterval{ 60 };
+    };
+
+    struct SimulationResults
+    {
+        int gamesPlayed = 0;
+        int adjudicatedGames = 0;
+        int wallTimeGames = 0; // of the adjudicated games, those that ran out of time rather than turns
+        long long turnsPlayed = 0;
+        long long recordsWritten = 0;
+        std::vector<int> winsBySeat;
+        GameStatistics statistics;
+        double seconds = 0.0;
+
+        void merge(SimulationResults const& other);
+    };
+
+    // The games of a run that are done: every game before a watermark, and the few past it
+    //
+    // Games are handed out in index order, so only games that finished while
+    // an earlier one was still being played sit past the watermark. The set
+    // stays about as small as the thread count however long the run is.
+    class CompletedGames
+    {
+    public:
+        explicit CompletedGames(int watermark = 0, std::set<int> above = {});
+
+        void add(int gameIndex);
+        bool contains(int gameIndex) const;
+
+        // Every game before this index is done
+        int get_watermark() const {
+            return watermark;
+        }
+        std::set<int> const& get_above() const {
+            return above;
+        }
+
+    private:
+        int watermark;
+        std::set<int> above;
+    };
+
+    // Progress of a run, saved every so often so that an interrupted run can be resumed
+    //
+    // Games still being played when a checkpoint is saved are left out of it
+    // and played again from the start on resuming. Every game only depends on
+    // its index, so the resumed run ends with exactly the results of a run
+    // that was never stopped.
+    struct SimulationCheckpoint
+    {
+        static constexpr char Magic[8] = { 'M', 'O', 'N', 'O', 'C', 'K', 'P', 'T' };
+        static constexpr uint32_t Version = 2;
+
+        std::string settings; // the options that decide how games are played, which a resumed run must share
+        CompletedGames completed;
+        SimulationResults results;
+
+        // Written to a temporary file that then replaces the one at path, so that an interruption
+        // leaves the previous checkpoint whole
+        void save(std::string const& path) const;
+        // False if there is no file at path, throws if the file is not a whole checkpoint
+        bool load(std::string const& path);
+    };
+
+    // Plays complete bot-vs-bot games across a pool of threads
+    //
+    // Every game is seeded from the master seed and its game index, so the
+    // outcome of each game does not depend on the thread count. When recording,
+    // game g goes to shard g % shardCount and each shard has its own writer
+    // thread, so the shards are the same for the same seed on any thread count.
+    // Each worker thread collects statistics on its own and they are merged
+    // once every game is done. With a checkpoint path, each game is merged
+    // into the run's progress as soon as it is done instead, so that a
+    // checkpoint can be saved at any time.
+    class BatchSimulator
+    {
+    public:
+        explicit BatchSimulator(SimulationOptions options);
+
+        std::string const& seat_policy_name(int seat) const;
+        SimulationResults run() const;
+        GameSetup game_setup(int gameIndex) const;
+        // The options that decide how games are played and counted, which a resumed run must share.
+        // The game count isn't one of them, so a finished run can be resumed with more games.
+        std::string settings() const;
+        std::string shard_path(int shard) const;
+
+    private:
+        // Progress of a run shared by its worker threads, only used when saving checkpoints
+        struct Progress
+        {
+            SimulationCheckpoint checkpoint; // seconds only counts the runs before this one
+            std::chrono::steady_clock::time_point start;
+            std::chrono::steady_clock::time_point nextSave;
+            std::mutex mutex;
+            std::mutex saveMutex;
+            std::string error; // why a checkpoint couldn't be saved, guarded by saveMutex
+            std::atomic<bool> failed{ false }; // set once there is an error, so the workers stop
+        };
+
+        // Merge the results of a game into the progress of the run, then save a checkpoint if one is due
+        void complete_game(int gameIndex, SimulationResults& results, Progress& progress) const;
+        void save_checkpoint(Progress& progress) const;
+        std::vector<std::unique_ptr<ShardWriter>> open_shards() const;
+        SimulationResults empty_results() const;
+        void play_game(int gameIndex, std::vector<std::unique_ptr<ShardWriter>> const& writers, SimulationResults& results) const;
+
+        SimulationOptions const options;
+        std::shared_ptr<AuctionBidder const> const auctionBidder;
+    };
+}
@@ -0,0 +1,169 @@
+#include "Bidding.h"
+#include "Game.h"
+using namespace monopoly;
+
+#include <algorithm>
+
+namespace
+{
+    constexpr int OwnedCounts = EquityTable::MaxOwnedInGroup + 1;
+
+    std::size_t table_index(Property property, int ownedInGroup, int opponentsOwnedInGroup, int liquidityStep) {
+        return ((static_cast<std::size_t> (property) * OwnedCounts + ownedInGroup) * OwnedCounts + opponentsOwnedInGroup)
+            * EquityTable::LiquiditySteps + liquidityStep;
+    }
+
+    // Rent multiplier bonus for owning one more deed of the group than ownedInGroup
+    double marginal_group_bonus(Property property, int ownedInGroup, double completionBonus) {
+        auto const group = properties_in_group(property_group(property));
+        if (property_is_in_group(property, PropertyGroup::Railroad)) {
+            // Rent doubles with each railroad
+            auto const bonus = [](int owned) { return owned == 0 ? 0 : owned * (25 << (owned - 1)); };
+            return bonus(ownedInGroup + 1) - bonus(ownedInGroup);
+        }
+        if (property_is_in_group(property, PropertyGroup::Utility)) {
+            return ownedInGroup == 1 ? 75 : 0;
+        }
+        // Most of the bonus comes with the last deeds of the group
+        auto groupPrice = 0;
+        for (auto p : group) {
+            groupPrice += price_of_property(p);
+        }
+        auto const groupSize = group.size();
+        return completionBonus * groupPrice * (2 * ownedInGroup + 1) / (groupSize * groupSize);
+    }
+}
+
+EquityTable::EquityTable(EquityTableOptions options)
+    : table(PropertyCount * OwnedCounts * OwnedCounts * LiquiditySteps)
+{
+    for (auto i = 0; i < PropertyCount; ++i) {
+        auto const property = static_cast<Property> (i);
+        for (auto owned = 0; owned < OwnedCounts; ++owned) {
+            for (auto opponents = 0; opponents < OwnedCounts; ++opponents) {
+                auto const equity = price_of_property(property)
+                    + marginal_group_bonus(property, owned, options.completionBonus)
+                    + options.blockingPremium * marginal_group_bonus(property, opponents, options.completionBonus);
+                for (auto step = 0; step < LiquiditySteps; ++step) {
+                    auto const liquidity = std::min(1.0, static_cast<double> (step * LiquidityStep) / std::max(1, options.fullValueLiquidity));
+                    auto const cashFactor = options.minimumCashFactor + (1.0 - options.minimumCashFactor) * liquidity;
+                    table[table_index(property, owned, opponents, step)] = static_cast<int> (equity * cashFactor);
+                }
+            }
+        }
+    }
+}
+
+int EquityTable::lookup(Property property, int ownedInGroup, int opponentsOwnedInGroup, int liquidAssets) const {
+    auto const owned = std::clamp(ownedInGroup, 0, MaxOwnedInGroup);
+    auto const opponents = std::clamp(opponentsOwnedInGroup, 0, MaxOwnedInGroup);
+    auto const step = std::clamp(liquidAssets / LiquidityStep, 0, LiquiditySteps - 1);
+    return table[table_index(property, owned, opponents, step)];
+}
+
+int EquityTable::max_bid(GameState const& state, int playerIndex, Property property) const {
+    auto const group = property_group(property);
+    auto opponentsOwned = 0;
+    for (auto p = 0; p < state.get_player_count(); ++p) {
+        if (p != playerIndex && !state.get_player_eliminated(p)) {
+            opponentsOwned = std::max(opponentsOwned, state.get_properties_owned_in_group_by_player(p, group));
+        }
+    }
+    auto const liquidAssets = state.calculate_liquid_assets_value(playerIndex);
+    auto const equity = lookup(property, state.get_properties_owned_in_group_by_player(playerIndex, group), opponentsOwned, liquidAssets);
+    return std::min(equity, liquidAssets - state.calculate_closing_costs_on_sale(property));
+}
+
+AuctionOutcome monopoly::simulate_auction(Auction const& auction, std::array<int, MaxPlayerCount> const& maxBids, int increment) {
+    auto order = auction.biddingOrder;
+    auto highestBid = auction.highestBid;
+    while (order.size() > 1) {
+        auto const bidder = order.front();
+        order.erase(order.begin());
+        if (highestBid + increment <= maxBids[bidder]) {
+            highestBid += increment;
+            order.push_back(bidder);
+        }
+    }
+    return AuctionOutcome{ order.back(), highestBid };
+}
+
+AuctionBidder::AuctionBidder(EquityTableOptions options, int increment)
+    : table(std::move(options))
+    , increment(std::max(1, increment))
+{
+}
+
+Input AuctionBidder::decide(GameState const& state, int playerIndex) const {
+    auto const auction = state.get_current_auction();
+    auto const amount = auction.highestBid + increment;
+    if (amount <= table.max_bid(state, playerIndex, auction.property) && state.check_if_player_is_allowed_to_bid(playerIndex, amount)) {
+        return BidInput{ amount };
+    }
+    return DeclineBidInput{};
+}
+
+AuctionOutcome AuctionBidder::predict(GameState const& state) const {
+    return simulate_auction(state.get_current_auction(), max_bids(state), increment);
+}
+
+std::vector<PlayerIndexInputPair> AuctionBidder::settlement(GameState const& state) const {
+    std::vector<PlayerIndexInputPair> inputs;
+    if (state.get_turn_phase() != TurnPhase::WaitingForBids) {
+        return inputs;
+    }
+    auto const auction = state.get_current_auction();
+    auto const maxBids = max_bids(state);
+    auto const outcome = simulate_auction(auction, maxBids, increment);
+    if (auction.biddingOrder.back() == outcome.winner && outcome.price > auction.highestBid) {
+        // The winner already holds the highest bid and can't raise their own bid. The other bidder willing to
+        // go highest bids just under the price, at or below what they bid when raising one step at a time.
+        auto runnerUp = Player::None;
+        for (auto bidder : auction.biddingOrder) {
+            if (bidder != outcome.winner && (runnerUp == Player::None || maxBids[bidder] > maxBids[runnerUp])) {
+                runnerUp = bidder;
+            }
+        }
+        // Bidders ahead of the runner up decline, then the runner up bids and goes to the back behind the winner
+        auto it = auction.biddingOrder.begin();
+        for (; *it != runnerUp; ++it) {
+            inputs.push_back(PlayerIndexInputPair{ *it, DeclineBidInput{} });
+        }
+        inputs.push_back(PlayerIndexInputPair{ runnerUp, BidInput{ outcome.price - increment } });
+        for (++it; *it != outcome.winner; ++it) {
+            inputs.push_back(PlayerIndexInputPair{ *it, DeclineBidInput{} });
+        }
+        inputs.push_back(PlayerIndexInputPair{ outcome.winner, BidInput{ outcome.price } });
+        inputs.push_back(PlayerIndexInputPair{ runnerUp, DeclineBidInput{} });
+        return inputs;
+    }
+    // The highest bidder is at the back of the order, everyone ahead of them declines except the winner
+    for (auto bidder : auction.biddingOrder) {
+        if (bidder != outcome.winner) {
+            inputs.push_back(PlayerIndexInputPair{ bidder, DeclineBidInput{} });
+        }
+        else if (outcome.price > auction.highestBid) {
+            inputs.push_back(PlayerIndexInputPair{ bidder, BidInput{ outcome.price } });
+        }
+    }
+    return inputs;
+}
+
+void AuctionBidder::settle(GameState& state) const {
+    for (auto const& [playerIndex, input] : settlement(state)) {
+        apply_input(state, playerIndex, input);
+    }
+}
+
+EquityTable const& AuctionBidder::get_table() const {
+    return table;
+}
+
+std::array<int, MaxPlayerCount> AuctionBidder::max_bids(GameState const& state) const {
+    std::array<int, MaxPlayerCount> maxBids{};
+    auto const property = state.get_current_auction().property;
+    for (auto bidder : state.get_current_auction().biddingOrder) {
+        maxBids[bidder] = table.max_bid(state, bidder, property);
+    }
+    return maxBids;
+}
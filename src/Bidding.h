@@ -0,0 +1,85 @@
+#pragma once
+
+#include "GameState.h"
+#include "Input.h"
+
+#include <array>
+#include <vector>
+
+namespace monopoly
+{
+    struct EquityTableOptions
+    {
+        // Completing a color group is worth this fraction of the group's printed price on top of the deeds
+        double completionBonus = 1.0;
+        // Keeping a deed from the opponent furthest along in its group is worth this fraction of what it is worth to them
+        double blockingPremium = 0.5;
+        // Players with less than this in liquid assets discount deeds, down to minimumCashFactor when they have nothing
+        int fullValueLiquidity = 1000;
+        double minimumCashFactor = 0.5;
+    };
+
+    // What an unowned deed is worth to a player
+    //
+    // Precomputed for every property, number of deeds the player already owns in
+    // its group, most deeds any one opponent owns in the group, and the player's
+    // liquid assets in $100 steps. A deed is worth its price plus its share of the
+    // group's rent multiplier, plus a premium for keeping it from an opponent, and
+    // a player short of cash discounts all of that.
+    class EquityTable
+    {
+    public:
+        static constexpr int MaxOwnedInGroup = 3;
+        static constexpr int LiquidityStep = 100;
+        // The last step covers all liquid assets from $2000 up
+        static constexpr int LiquiditySteps = 21;
+
+        explicit EquityTable(EquityTableOptions options = {});
+
+        int lookup(Property property, int ownedInGroup, int opponentsOwnedInGroup, int liquidAssets) const;
+        // Most playerIndex should pay for property at auction, never more than they can raise including closing costs
+        int max_bid(GameState const& state, int playerIndex, Property property) const;
+
+    private:
+        std::vector<int> table;
+    };
+
+    struct AuctionOutcome
+    {
+        int winner;
+        int price;
+    };
+
+    // Outcome of the auction if each bidder in turn raises the highest bid by the increment while it stays within
+    // their maximum bid, and declines otherwise
+    AuctionOutcome simulate_auction(Auction const& auction, std::array<int, MaxPlayerCount> const& maxBids, int increment = 1);
+
+    // Bids for bots up to the maximum an equity table allows
+    //
+    // When every bidder is a bot the whole auction can be settled at once: the
+    // winner and price are worked out from everyone's maximum bid, then the winner
+    // bids that price and everyone else declines. A winner who already holds the
+    // highest bid is first outbid by the runner up, just under the price.
+    class AuctionBidder
+    {
+    public:
+        explicit AuctionBidder(EquityTableOptions options = {}, int increment = 1);
+
+        // Raise the highest bid by the increment, or decline
+        Input decide(GameState const& state, int playerIndex) const;
+        // Winner and price of the current auction if every bidder bids with this bidder
+        AuctionOutcome predict(GameState const& state) const;
+        // Inputs that settle the current auction, in the order they must be processed
+        std::vector<PlayerIndexInputPair> settlement(GameState const& state) const;
+        // Apply the settlement of the current auction to state
+        void settle(GameState& state) const;
+
+        EquityTable const& get_table() const;
+
+    private:
+        std::array<int, MaxPlayerCount> max_bids(GameState const& state) const;
+
+        EquityTable const table;
+        int const increment;
+    };
+}
@@ -4,8 +4,9 @@
 #include <array>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
+#include <initializer_list>
 #include <iterator>
-#include <set>
 #include <string>
 #include <vector>
 
@@ -18,8 +19,9 @@ namespace monopoly
     static constexpr int GoSalary = 200;
     static constexpr double MortgageInterestRate = 0.10;
     static constexpr int DeedTableColumns = 9;
+    static constexpr int PropertyCount = 28;
 
-    static std::vector<int> const DeedTable = {
+    static constexpr std::array<int, (PropertyCount + 1) * DeedTableColumns> DeedTable = {
         //  PRC,  BLD,  RNT, RNT1, RNT2, RNT3, RNT4, RNTH,  MTG,
              60,   50,    2,   10,   30,   90,  160,  250,   30, // Brown 1
              60,   50,    4,   20,   60,  180,  320,  450,   30, // Brown 2
@@ -105,180 +107,178 @@ namespace monopoly
         Invalid = -1,
     };
 
-    inline PropertyGroup property_group(Property p) {
-        switch (p) {
-        case Property::Brown_1:
-        case Property::Brown_2:
-            return PropertyGroup::Brown;
-        case Property::LightBlue_1:
-        case Property::LightBlue_2:
-        case Property::LightBlue_3:
-            return PropertyGroup::LightBlue;
-        case Property::Magenta_1:
-        case Property::Magenta_2:
-        case Property::Magenta_3:
-            return PropertyGroup::Magenta;
-        case Property::Orange_1:
-        case Property::Orange_2:
-        case Property::Orange_3:
-            return PropertyGroup::Orange;
-        case Property::Red_1:
-        case Property::Red_2:
-        case Property::Red_3:
-            return PropertyGroup::Red;
-        case Property::Yellow_1:
-        case Property::Yellow_2:
-        case Property::Yellow_3:
-            return PropertyGroup::Yellow;
-        case Property::Green_1:
-        case Property::Green_2:
-        case Property::Green_3:
-            return PropertyGroup::Green;
-        case Property::Blue_1:
-        case Property::Blue_2:
-            return PropertyGroup::Blue;
-        case Property::Utility_1:
-        case Property::Utility_2:
-            return PropertyGroup::Utility;
-        case Property::Railroad_1:
-        case Property::Railroad_2:
-        case Property::Railroad_3:
-        case Property::Railroad_4:
-            return PropertyGroup::Railroad;
-        case Property::Invalid:
+    inline constexpr int popcount(uint32_t bits) {
+        bits = bits - ((bits >> 1) & 0x55555555u);
+        bits = (bits & 0x33333333u) + ((bits >> 2) & 0x33333333u);
+        bits = (bits + (bits >> 4)) & 0x0F0F0F0Fu;
+        return static_cast<int> ((bits * 0x01010101u) >> 24);
+    }
+
+    inline constexpr int lowest_set_bit_index(uint32_t bits) {
+        return popcount((bits & (~bits + 1)) - 1);
+    }
+
+    // A set of properties, one bit per property
+    //
+    // Iterates in property order (the same order as std::set<Property>), and
+    // every query is a handful of bitwise operations on a single word.
+    class PropertySet
+    {
+    public:
+        class iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Property;
+            using difference_type = std::ptrdiff_t;
+            using pointer = Property const*;
+            using reference = Property;
+
+            constexpr explicit iterator(uint32_t bits = 0) : bits(bits) {}
+            constexpr Property operator*() const { return static_cast<Property> (lowest_set_bit_index(bits)); }
+            constexpr iterator& operator++() { bits &= bits - 1; return *this; }
+            constexpr iterator operator++(int) { auto ret = *this; ++(*this); return ret; }
+            constexpr bool operator==(iterator const& rhs) const { return bits == rhs.bits; }
+            constexpr bool operator!=(iterator const& rhs) const { return bits != rhs.bits; }
+
+        private:
+            uint32_t bits;
+        };
+        using const_iterator = iterator;
+        using value_type = Property;
+
+        constexpr PropertySet() = default;
+        constexpr PropertySet(std::initializer_list<Property> properties) {
+            for (auto p : properties) {
+                insert(p);
+            }
+        }
+        static constexpr PropertySet from_mask(uint32_t mask) {
+            PropertySet ret;
+            ret.bits = mask;
+            return ret;
+        }
+
+        static constexpr uint32_t bit(Property p) {
+            return p == Property::Invalid ? 0 : uint32_t{ 1 } << static_cast<int> (p);
+        }
+
+        constexpr uint32_t mask() const { return bits; }
+        constexpr int size() const { return popcount(bits); }
+        constexpr bool empty() const { return bits == 0; }
+        constexpr bool contains(Property p) const { return (bits & bit(p)) != 0; }
+        constexpr int count(Property p) const { return contains(p) ? 1 : 0; }
+        constexpr bool contains_all(PropertySet other) const { return (bits & other.bits) == other.bits; }
+        constexpr iterator begin() const { return iterator(bits); }
+        constexpr iterator end() const { return iterator(); }
+
+        // Returns false if the property was already in the set
+        constexpr bool insert(Property p) {
+            auto const inserted = !contains(p);
+            bits |= bit(p);
+            return inserted;
+        }
+        constexpr void insert(PropertySet other) { bits |= other.bits; }
+        // Returns the number of properties removed (0 or 1)
+        constexpr int erase(Property p) {
+            auto const erased = count(p);
+            bits &= ~bit(p);
+            return erased;
+        }
+        constexpr void clear() { bits = 0; }
+
+        constexpr PropertySet operator&(PropertySet rhs) const { return from_mask(bits & rhs.bits); }
+        constexpr PropertySet operator|(PropertySet rhs) const { return from_mask(bits | rhs.bits); }
+        constexpr PropertySet operator-(PropertySet rhs) const { return from_mask(bits & ~rhs.bits); }
+        constexpr bool operator==(PropertySet rhs) const { return bits == rhs.bits; }
+        constexpr bool operator!=(PropertySet rhs) const { return bits != rhs.bits; }
+
+        // Provided for emscripten, embind doesn't work well with STD containers
+        Property at(int i) const {
+            auto it = begin();
+            std::advance(it, i);
+            return *it;
+        }
+
+    private:
+        uint32_t bits = 0;
+    };
+
+    static constexpr std::array<PropertyGroup, PropertyCount> PropertyGroups = {
+        PropertyGroup::Brown, PropertyGroup::Brown,
+        PropertyGroup::LightBlue, PropertyGroup::LightBlue, PropertyGroup::LightBlue,
+        PropertyGroup::Magenta, PropertyGroup::Magenta, PropertyGroup::Magenta,
+        PropertyGroup::Orange, PropertyGroup::Orange, PropertyGroup::Orange,
+        PropertyGroup::Red, PropertyGroup::Red, PropertyGroup::Red,
+        PropertyGroup::Yellow, PropertyGroup::Yellow, PropertyGroup::Yellow,
+        PropertyGroup::Green, PropertyGroup::Green, PropertyGroup::Green,
+        PropertyGroup::Blue, PropertyGroup::Blue,
+        PropertyGroup::Utility, PropertyGroup::Utility,
+        PropertyGroup::Railroad, PropertyGroup::Railroad, PropertyGroup::Railroad, PropertyGroup::Railroad,
+    };
+
+    static constexpr std::array<PropertySet, 10> PropertiesByGroup = {
+        PropertySet{ Property::Brown_1, Property::Brown_2 },
+        PropertySet{ Property::LightBlue_1, Property::LightBlue_2, Property::LightBlue_3 },
+        PropertySet{ Property::Magenta_1, Property::Magenta_2, Property::Magenta_3 },
+        PropertySet{ Property::Orange_1, Property::Orange_2, Property::Orange_3 },
+        PropertySet{ Property::Red_1, Property::Red_2, Property::Red_3 },
+        PropertySet{ Property::Yellow_1, Property::Yellow_2, Property::Yellow_3 },
+        PropertySet{ Property::Green_1, Property::Green_2, Property::Green_3 },
+        PropertySet{ Property::Blue_1, Property::Blue_2 },
+        PropertySet{ Property::Utility_1, Property::Utility_2 },
+        PropertySet{ Property::Railroad_1, Property::Railroad_2, Property::Railroad_3, Property::Railroad_4 },
+    };
+
+    inline constexpr PropertyGroup property_group(Property p) {
+        if (p == Property::Invalid) {
             return PropertyGroup::Invalid;
         }
-        assert(false); // unreachable
-        return PropertyGroup::Railroad;
+        return PropertyGroups[static_cast<size_t> (p)];
     }
 
-    inline std::set<Property> properties_in_group(PropertyGroup group) {
-        static const std::vector<std::set<Property>> propertiesByGroup = {
-            {
-                Property::Brown_1,
-                Property::Brown_2,
-            },
-            {
-                Property::LightBlue_1,
-                Property::LightBlue_2,
-                Property::LightBlue_3,
-            },
-            {
-                Property::Magenta_1,
-                Property::Magenta_2,
-                Property::Magenta_3,
-            },
-            {
-                Property::Orange_1,
-                Property::Orange_2,
-                Property::Orange_3,
-            },
-            {
-                Property::Red_1,
-                Property::Red_2,
-                Property::Red_3,
-            },
-            {
-                Property::Yellow_1,
-                Property::Yellow_2,
-                Property::Yellow_3,
-            },
-            {
-                Property::Green_1,
-                Property::Green_2,
-                Property::Green_3,
-            },
-            {
-                Property::Blue_1,
-                Property::Blue_2,
-            },
-            {
-                Property::Utility_1,
-                Property::Utility_2,
-            },
-            {
-                Property::Railroad_1,
-                Property::Railroad_2,
-                Property::Railroad_3,
-                Property::Railroad_4,
-            },
-        };
-        return propertiesByGroup[static_cast<int> (group)];
+    inline constexpr PropertySet properties_in_group(PropertyGroup group) {
+        if (group == PropertyGroup::Invalid) {
+            return {};
+        }
+        return PropertiesByGroup[static_cast<size_t> (group)];
     }
 
-    inline bool property_is_in_group(Property p, PropertyGroup g) {
+    inline constexpr bool property_is_in_group(Property p, PropertyGroup g) {
         return property_group(p) == g;
     }
 
-    inline std::set<Property> const all_properties() {
-        return {
-            Property::Brown_1,
-            Property::Brown_2,
-            Property::LightBlue_1,
-            Property::LightBlue_2,
-            Property::LightBlue_3,
-            Property::Magenta_1,
-            Property::Magenta_2,
-            Property::Magenta_3,
-            Property::Orange_1,
-            Property::Orange_2,
-            Property::Orange_3,
-            Property::Red_1,
-            Property::Red_2,
-            Property::Red_3,
-            Property::Yellow_1,
-            Property::Yellow_2,
-            Property::Yellow_3,
-            Property::Green_1,
-            Property::Green_2,
-            Property::Green_3,
-            Property::Blue_1,
-            Property::Blue_2,
-            Property::Utility_1,
-            Property::Utility_2,
-            Property::Railroad_1,
-            Property::Railroad_2,
-            Property::Railroad_3,
-            Property::Railroad_4,
-        };
+    inline constexpr PropertySet all_properties() {
+        return PropertySet::from_mask((uint32_t{ 1 } << PropertyCount) - 1);
     }
 
-    inline int real_estate_table_lookup(Property p, DeedField f) {
+    inline constexpr int real_estate_table_lookup(Property p, DeedField f) {
         int const row = static_cast<int> (p);
         int const col = static_cast<int> (f);
-        if (row >= all_properties().size()) {
+        if (row < 0 || row >= PropertyCount) {
             return 0;
         }
-        if (col >= DeedTableColumns) {
+        if (col < 0 || col >= DeedTableColumns) {
             return 0;
         }
         return DeedTable[static_cast<size_t> (row * DeedTableColumns + col)];
     }
 
-
-    inline int price_of_property(Property p) {
-        if (property_is_in_group(p, PropertyGroup::Railroad)) {
-            return 200;
-        }
-        else if (property_is_in_group(p, PropertyGroup::Utility)) {
-            return 150;
-        }
-        else {
-            return real_estate_table_lookup(p, DeedField::Price);
-        }
+    inline constexpr int price_of_property(Property p) {
+        return real_estate_table_lookup(p, DeedField::Price);
     }
 
-    inline int price_per_house_on_property(Property p) {
+    inline constexpr int price_per_house_on_property(Property p) {
         return real_estate_table_lookup(p, DeedField::PricePerHouse);
     }
 
-    inline int sell_price_per_house_on_property(Property p) {
+    inline constexpr int sell_price_per_house_on_property(Property p) {
         return price_per_house_on_property(p) / 2;
     }
-    inline int rent_price_of_real_estate(Property p) {
+    inline constexpr int rent_price_of_real_estate(Property p) {
         return real_estate_table_lookup(p, DeedField::Rent);
     }
-    inline int rent_price_of_improved_real_estate(Property p, int buildingLevel) {
+    inline constexpr int rent_price_of_improved_real_estate(Property p, int buildingLevel) {
         int price = real_estate_table_lookup(p, static_cast<DeedField> (static_cast<int> (DeedField::Rent) + buildingLevel));
         if (buildingLevel == 0) {
             return price * 2;
@@ -287,23 +287,27 @@ namespace monopoly
             return price;
         }
     }
-    inline int rent_price_of_railroad(int ownedRailroads) {
-        return 25 * pow(2, ownedRailroads - 1);
+    inline constexpr int rent_price_of_railroad(int ownedRailroads) {
+        if (ownedRailroads <= 0) {
+            return 0;
+        }
+        return 25 << (ownedRailroads - 1);
     }
-    inline int rent_price_of_utility(int ownedUtilities, std::pair<int, int> roll) {
+    inline constexpr int rent_price_of_utility(int ownedUtilities, std::pair<int, int> roll) {
         auto const sum = roll.first + roll.second;
         if (ownedUtilities == 1)
             return 4 * sum;
         else
             return 10 * sum;
     }
-    inline int mortgage_value_of_property(Property p) {
+    inline constexpr int mortgage_value_of_property(Property p) {
         return real_estate_table_lookup(p, DeedField::Mortgage);
     }
-    inline int unmortgage_price_of_property(Property p) {
-        return real_estate_table_lookup(p, DeedField::Mortgage) * (1 + MortgageInterestRate);
+    inline constexpr int unmortgage_price_of_property(Property p) {
+        return static_cast<int> (real_estate_table_lookup(p, DeedField::Mortgage) * (1 + MortgageInterestRate));
     }
 
+
     enum class Space
     {
         Go = 0,
@@ -353,101 +357,70 @@ namespace monopoly
         Invalid = -1,
     };
 
-    inline Property space_to_property(Space s) {
-        switch (s) {
-        case Space::Brown_1: return Property::Brown_1;
-        case Space::Brown_2: return Property::Brown_2;
-        case Space::LightBlue_1: return Property::LightBlue_1;
-        case Space::LightBlue_2: return Property::LightBlue_2;
-        case Space::LightBlue_3: return Property::LightBlue_3;
-        case Space::Magenta_1: return Property::Magenta_1;
-        case Space::Magenta_2: return Property::Magenta_2;
-        case Space::Magenta_3: return Property::Magenta_3;
-        case Space::Orange_1: return Property::Orange_1;
-        case Space::Orange_2: return Property::Orange_2;
-        case Space::Orange_3: return Property::Orange_3;
-        case Space::Red_1: return Property::Red_1;
-        case Space::Red_2: return Property::Red_2;
-        case Space::Red_3: return Property::Red_3;
-        case Space::Yellow_1: return Property::Yellow_1;
-        case Space::Yellow_2: return Property::Yellow_2;
-        case Space::Yellow_3: return Property::Yellow_3;
-        case Space::Green_1: return Property::Green_1;
-        case Space::Green_2: return Property::Green_2;
-        case Space::Green_3: return Property::Green_3;
-        case Space::Blue_1: return Property::Blue_1;
-        case Space::Blue_2: return Property::Blue_2;
-        case Space::Utility_1: return Property::Utility_1;
-        case Space::Utility_2: return Property::Utility_2;
-        case Space::Railroad_1: return Property::Railroad_1;
-        case Space::Railroad_2: return Property::Railroad_2;
-        case Space::Railroad_3: return Property::Railroad_3;
-        case Space::Railroad_4: return Property::Railroad_4;
-        default: break;
+
+    static constexpr std::array<Space, PropertyCount> SpaceByProperty = {
+        Space::Brown_1, Space::Brown_2,
+        Space::LightBlue_1, Space::LightBlue_2, Space::LightBlue_3,
+        Space::Magenta_1, Space::Magenta_2, Space::Magenta_3,
+        Space::Orange_1, Space::Orange_2, Space::Orange_3,
+        Space::Red_1, Space::Red_2, Space::Red_3,
+        Space::Yellow_1, Space::Yellow_2, Space::Yellow_3,
+        Space::Green_1, Space::Green_2, Space::Green_3,
+        Space::Blue_1, Space::Blue_2,
+        Space::Utility_1, Space::Utility_2,
+        Space::Railroad_1, Space::Railroad_2, Space::Railroad_3, Space::Railroad_4,
+    };
+
+    // Inverse of SpaceByProperty, Property::Invalid for spaces that aren't properties
+    static constexpr std::array<Property, NumberOfSpaces> PropertyBySpace = []() {
+        std::array<Property, NumberOfSpaces> ret{};
+        for (auto& property : ret) {
+            property = Property::Invalid;
         }
-        return Property::Invalid;
-    }
+        for (auto p = 0; p < PropertyCount; ++p) {
+            ret[static_cast<size_t> (SpaceByProperty[p])] = static_cast<Property> (p);
+        }
+        return ret;
+    }();
 
-    inline Space property_to_space(Property p) {
-        switch (p) {
-        case Property::Brown_1: return Space::Brown_1;
-        case Property::Brown_2: return Space::Brown_2;
-        case Property::LightBlue_1: return Space::LightBlue_1;
-        case Property::LightBlue_2: return Space::LightBlue_2;
-        case Property::LightBlue_3: return Space::LightBlue_3;
-        case Property::Magenta_1: return Space::Magenta_1;
-        case Property::Magenta_2: return Space::Magenta_2;
-        case Property::Magenta_3: return Space::Magenta_3;
-        case Property::Orange_1: return Space::Orange_1;
-        case Property::Orange_2: return Space::Orange_2;
-        case Property::Orange_3: return Space::Orange_3;
-        case Property::Red_1: return Space::Red_1;
-        case Property::Red_2: return Space::Red_2;
-        case Property::Red_3: return Space::Red_3;
-        case Property::Yellow_1: return Space::Yellow_1;
-        case Property::Yellow_2: return Space::Yellow_2;
-        case Property::Yellow_3: return Space::Yellow_3;
-        case Property::Green_1: return Space::Green_1;
-        case Property::Green_2: return Space::Green_2;
-        case Property::Green_3: return Space::Green_3;
-        case Property::Blue_1: return Space::Blue_1;
-        case Property::Blue_2: return Space::Blue_2;
-        case Property::Utility_1: return Space::Utility_1;
-        case Property::Utility_2: return Space::Utility_2;
-        case Property::Railroad_1: return Space::Railroad_1;
-        case Property::Railroad_2: return Space::Railroad_2;
-        case Property::Railroad_3: return Space::Railroad_3;
-        case Property::Railroad_4: return Space::Railroad_4;
-        case Property::Invalid: break;
+    inline constexpr Property space_to_property(Space s) {
+        if (s == Space::Invalid) {
+            return Property::Invalid;
         }
-        return Space::Go;
+        return PropertyBySpace[static_cast<size_t> (s)];
     }
 
+    inline constexpr Space property_to_space(Property p) {
+        if (p == Property::Invalid) {
+            return Space::Go;
+        }
+        return SpaceByProperty[static_cast<size_t> (p)];
+    }
 
-    inline bool space_is_property(Space s) {
+    inline constexpr bool space_is_property(Space s) {
         return space_to_property(s) != Property::Invalid;
     }
 
-    inline int space_to_index(Space s) {
+    inline constexpr int space_to_index(Space s) {
         return static_cast<int> (s);
     }
 
-    inline Space index_to_space(int i) {
+    inline constexpr Space index_to_space(int i) {
         return static_cast<Space> (i % NumberOfSpaces);
     }
 
-    inline bool advancing_will_pass_go(Space s, int dist) {
+    inline constexpr bool advancing_will_pass_go(Space s, int dist) {
         return (space_to_index(s) + dist) >= 40;
     }
 
-    inline int distance(Space from, Space to) {
+    inline constexpr int distance(Space from, Space to) {
         auto d = static_cast<int> (to) - static_cast<int> (from);
         if (d < 0)
             d += NumberOfSpaces;
         return d;
     }
 
-    inline Space add_distance(Space from, int dist) {
+    inline constexpr Space add_distance(Space from, int dist) {
         return index_to_space(space_to_index(from) + dist);
     }
 
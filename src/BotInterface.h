@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Bidding.h"
+#include "IInterface.h"
+
+#include <memory>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace monopoly
+{
+    // Decides the inputs for a single seat
+    class IPolicy
+    {
+    public:
+        virtual ~IPolicy() = default;
+        // Choose the next input for playerIndex, who is the controlling player of state.
+        // Inputs that fail their check_if_player_is_allowed_to_* gate are ignored by the game, so a policy
+        // should only return inputs that pass them (resigning is always allowed).
+        virtual Input decide(GameState const& state, int playerIndex) = 0;
+    };
+
+    // Interface that plays every seat of a game with a policy, one input per process cycle
+    //
+    // Policies decide from the game's own state, which IInterface::update guarantees stays valid for
+    // as long as the game, so bots never copy it.
+    // With an auction bidder set, each auction is settled by the bidder in a single cycle instead.
+    class BotInterface : public IInterface
+    {
+    public:
+        BotInterface(GameSetup setup, std::vector<std::unique_ptr<IPolicy>> seatPolicies)
+            : IInterface()
+            , setup(std::move(setup))
+            , policies(std::move(seatPolicies))
+            , auctionBidder(nullptr)
+            , state(nullptr) {
+        }
+
+        void set_auction_bidder(std::shared_ptr<AuctionBidder const> bidder) {
+            auctionBidder = std::move(bidder);
+        }
+
+        GameSetup get_setup() override {
+            return setup;
+        }
+
+        std::queue<PlayerIndexInputPair> poll() override {
+            std::queue<PlayerIndexInputPair> ret;
+            if (state && !state->is_game_over() && auctionBidder && state->get_turn_phase() == TurnPhase::WaitingForBids) {
+                for (auto& input : auctionBidder->settlement(*state)) {
+                    ret.push(std::move(input));
+                }
+            }
+            else if (state && !state->is_game_over()) {
+                auto const playerIndex = state->get_controlling_player_index();
+                ret.push(PlayerIndexInputPair{ playerIndex, policies[playerIndex]->decide(*state, playerIndex) });
+            }
+            return ret;
+        }
+
+        void update(GameState const& newState) override {
+            state = &newState;
+        }
+
+    private:
+        GameSetup const setup;
+        std::vector<std::unique_ptr<IPolicy>> policies;
+        std::shared_ptr<AuctionBidder const> auctionBidder;
+        GameState const* state;
+    };
+}
@@ -7,31 +7,83 @@ using namespace monopoly;
 #include "nlohmann/json.hpp"
 
 #include <algorithm>
+#include <array>
 #include <iostream>
 
 namespace {
     int calculate_building_repair_cost(GameState const& state, int playerIndex, int pricePerHouse, int pricePerHotel) {
         int cost = 0;
-        for (auto propertyBuildingLevelPair : state.get_building_levels()) {
-            auto const& property = propertyBuildingLevelPair.first;
-            if (state.get_property_owner_index(property) == playerIndex) {
-                auto const buildingLevel = propertyBuildingLevelPair.second;
-                if (buildingLevel <= 4)
-                    cost += buildingLevel * pricePerHouse;
-                else
-                    cost += pricePerHotel;
-            }
+        auto const& buildingLevels = state.get_building_levels();
+        for (auto property : state.get_player_deeds(playerIndex)) {
+            int const buildingLevel = buildingLevels[static_cast<int> (property)];
+            if (buildingLevel < HotelLevel)
+                cost += buildingLevel * pricePerHouse;
+            else
+                cost += pricePerHotel;
         }
         return cost;
     }
 }
 
+namespace {
+    constexpr CardEffectData advance_to(Space space) {
+        return { CardEffectKind::AdvanceTo, 0, static_cast<int8_t> (space) };
+    }
+    constexpr CardEffectData effect(CardEffectKind kind, int16_t amount = 0) {
+        return { kind, amount };
+    }
+    constexpr CardEffectData repairs(int16_t perHouse, int16_t perHotel) {
+        return { CardEffectKind::Repairs, 0, 0, perHouse, perHotel };
+    }
+
+    // Indexed by Card
+    constexpr std::array<CardEffectData, CardCount> CardEffects = {
+        advance_to(Space::Blue_2),                                  // Chance_AdvanceToBlue2
+        advance_to(Space::Go),                                      // Chance_AdvanceToGo
+        advance_to(Space::Magenta_1),                               // Chance_AdvanceToMagenta1
+        effect(CardEffectKind::AdvanceToNearestRailroad),           // Chance_AdvanceToNearestRailroad
+        effect(CardEffectKind::AdvanceToNearestUtility),            // Chance_AdvanceToNearestUtility
+        advance_to(Space::Railroad_1),                              // Chance_AdvanceToRailroad1
+        advance_to(Space::Red_3),                                   // Chance_AdvanceToRed3
+        effect(CardEffectKind::Gain, 150),                          // Chance_Gain150
+        effect(CardEffectKind::Gain, 50),                           // Chance_Gain50
+        effect(CardEffectKind::GetOutOfJailFree),                   // Chance_GetOutOfJailFree
+        effect(CardEffectKind::Move, -3),                           // Chance_GoBack3Spaces
+        effect(CardEffectKind::GoToJail),                           // Chance_GoToJail
+        effect(CardEffectKind::Pay, 15),                            // Chance_Pay15
+        effect(CardEffectKind::PayEachPlayer, 50),                  // Chance_PayEachPlayer50
+        repairs(25, 100),                                           // Chance_Repairs
+        advance_to(Space::Go),                                      // CommunityChest_AdvanceToGo
+        effect(CardEffectKind::CollectFromEachPlayer, 50),          // CommunityChest_CollectFromEachPlayer50
+        effect(CardEffectKind::Gain, 10),                           // CommunityChest_Gain10
+        effect(CardEffectKind::Gain, 100),                          // CommunityChest_Gain100_A
+        effect(CardEffectKind::Gain, 100),                          // CommunityChest_Gain100_B
+        effect(CardEffectKind::Gain, 100),                          // CommunityChest_Gain100_C
+        effect(CardEffectKind::Gain, 20),                           // CommunityChest_Gain20
+        effect(CardEffectKind::Gain, 200),                          // CommunityChest_Gain200
+        effect(CardEffectKind::Gain, 25),                           // CommunityChest_Gain25
+        effect(CardEffectKind::Gain, 45),                           // CommunityChest_Gain45
+        effect(CardEffectKind::GetOutOfJailFree),                   // CommunityChest_GetOutOfJailFree
+        effect(CardEffectKind::GoToJail),                           // CommunityChest_GoToJail
+        effect(CardEffectKind::Pay, 100),                           // CommunityChest_Pay100
+        effect(CardEffectKind::Pay, 150),                           // CommunityChest_Pay150
+        effect(CardEffectKind::Pay, 50),                            // CommunityChest_Pay50
+        repairs(40, 115),                                           // CommunityChest_Repairs
+    };
+    static_assert(CardEffects[static_cast<int> (Card::Chance_Repairs)].kind == CardEffectKind::Repairs, "CardEffects is out of order");
+    static_assert(CardEffects[static_cast<int> (Card::CommunityChest_Repairs)].perHotel == 115, "CardEffects is out of order");
+
+    DeckType deck_type_of(Card card) {
+        return static_cast<int> (card) < static_cast<int> (Card::CommunityChest_AdvanceToGo) ? DeckType::Chance : DeckType::CommunityChest;
+    }
+}
+
 CardData const& monopoly::card_data(Card card) {
-    static std::unordered_map<Card, CardData> const card_data = []() {
-        std::unordered_map<Card, CardData> ret;
-        for (auto i = 0; i < ChanceCards.size() + CommunityChestCards.size(); ++i) {
+    static std::array<CardData, CardCount> const card_data = []() {
+        std::array<CardData, CardCount> ret;
+        for (auto i = 0; i < CardCount; ++i) {
             Card c = static_cast<Card> (i);
-            auto& singleCardData = ret[c];
+            auto& singleCardData = ret[i];
             try {
                 singleCardData.flavorText = card_flavor_text(c);
                 singleCardData.effectText = card_effect_text(c);
@@ -42,136 +94,81 @@ CardData const& monopoly::card_data(Card card) {
         }
         return ret;
     } ();
-    return card_data.at(card);
+    return card_data[static_cast<int> (card)];
+}
+
+CardEffectData const& monopoly::card_effect(Card card) {
+    return CardEffects[static_cast<int> (card)];
 }
 
 void monopoly::apply_card_effect(GameState& state, int playerIndex, Card card) {
-    static std::unordered_map<Card, CardEffect> const card_effects = []() {
-        std::unordered_map<Card, CardEffect> ret;
-        ret[Card::Chance_AdvanceToBlue2] = [](GameState& state, int playerIndex) {
-            state.force_advance_to(playerIndex, Space::Blue_2);
-        };
-        ret[Card::Chance_AdvanceToGo] = [](GameState& state, int playerIndex) {
-            state.force_advance_to(playerIndex, Space::Go);
-        };
-        ret[Card::Chance_AdvanceToMagenta1] = [](GameState& state, int playerIndex) {
-            state.force_advance_to(playerIndex, Space::Magenta_1);
-        };
-        ret[Card::Chance_AdvanceToNearestRailroad] = [](GameState& state, int playerIndex) {
-            auto const pos = state.get_player_position(playerIndex);
-            auto const dest = nearest_space(pos, { Space::Railroad_1, Space::Railroad_2, Space::Railroad_3, Space::Railroad_4 });
-            state.force_advance_to_without_landing(playerIndex, dest);
-            auto const property = space_to_property(dest);
-            auto const owner = state.get_property_owner_index(property);
-            if (owner != Player::None) {
-                auto const ownedGroupCount = state.get_properties_owned_in_group_by_player(owner, PropertyGroup::Railroad);
-                // Rent is doubled
-                state.force_transfer_funds(playerIndex, owner, 2 * rent_price_of_railroad(ownedGroupCount));
-            }
-            else {
-                state.force_property_offer(playerIndex, property);
-            }
-        };
-        ret[Card::Chance_AdvanceToNearestUtility] = [](GameState& state, int playerIndex) {
-            auto const pos = state.get_player_position(playerIndex);
-            auto const dest = nearest_space(pos, { Space::Utility_1, Space::Utility_2 });
-            state.force_advance_to_without_landing(playerIndex, dest);
-            auto const property = space_to_property(dest);
-            auto const owner = state.get_property_owner_index(property);
-            if (owner != Player::None) {
-                // Pay 10 times a random roll
-                auto const roll = state.random_dice_roll();
-                auto const sum = roll.first + roll.second;
-                state.force_transfer_funds(playerIndex, owner, 10 * sum);
-            }
-            else {
-                state.force_property_offer(playerIndex, property);
-            }
-        };
-        ret[Card::Chance_AdvanceToRailroad1] = [](GameState& state, int playerIndex) {
-            state.force_advance_to(playerIndex, Space::Railroad_1);
-        };
-        ret[Card::Chance_AdvanceToRed3] = [](GameState& state, int playerIndex) {
-            state.force_advance_to(playerIndex, Space::Red_3);
-        };
-        ret[Card::Chance_Gain150] = [](GameState& state, int playerIndex) {
-            state.force_add_funds(playerIndex, 150);
-        };
-        ret[Card::Chance_Gain50] = [](GameState& state, int playerIndex) {
-            state.force_add_funds(playerIndex, 50);
-        };
-        ret[Card::Chance_GetOutOfJailFree] = [](GameState& state, int playerIndex) {
-            state.force_give_get_out_of_jail_free_card(playerIndex, DeckType::Chance);
-        };
-        ret[Card::Chance_GoBack3Spaces] = [](GameState& state, int playerIndex) {
-            state.force_advance(playerIndex, -3);
-        };
-        ret[Card::Chance_GoToJail] = [](GameState& state, int playerIndex) {
-            state.force_go_to_jail(playerIndex);
-        };
-        ret[Card::Chance_Pay15] = [](GameState& state, int playerIndex) {
-            state.force_subtract_funds(playerIndex, 15);
-        };
-        ret[Card::Chance_PayEachPlayer50] = [](GameState& state, int playerIndex) {
-            for (auto p = 0; p < state.get_player_count(); ++p) {
-                state.force_transfer_funds(playerIndex, p, 50);
-            }
-        };
-        ret[Card::Chance_Repairs] = [](GameState& state, int playerIndex) {
-            state.force_subtract_funds(playerIndex, calculate_building_repair_cost(state, playerIndex, 25, 100));
-        };
-        ret[Card::CommunityChest_AdvanceToGo] = [](GameState& state, int playerIndex) {
-            state.force_advance_to(playerIndex, Space::Go);
-        };
-        ret[Card::CommunityChest_CollectFromEachPlayer50] = [](GameState& state, int playerIndex) {
-            for (auto p = 0; p < state.get_player_count(); ++p) {
-                state.force_transfer_funds(p, playerIndex, 50);
-            }
-        };
-        ret[Card::CommunityChest_Gain10] = [](GameState& state, int playerIndex) {
-            state.force_add_funds(playerIndex, 10);
-        };
-        ret[Card::CommunityChest_Gain100_A] = [](GameState& state, int playerIndex) {
-            state.force_add_funds(playerIndex, 100);
-        };
-        ret[Card::CommunityChest_Gain100_B] = [](GameState& state, int playerIndex) {
-            state.force_add_funds(playerIndex, 100);
-        };
-        ret[Card::CommunityChest_Gain100_C] = [](GameState& state, int playerIndex) {
-            state.force_add_funds(playerIndex, 100);
-        };
-        ret[Card::CommunityChest_Gain20] = [](GameState& state, int playerIndex) {
-            state.force_add_funds(playerIndex, 20);
-        };
-        ret[Card::CommunityChest_Gain200] = [](GameState& state, int playerIndex) {
-            state.force_add_funds(playerIndex, 200);
-        };
-        ret[Card::CommunityChest_Gain25] = [](GameState& state, int playerIndex) {
-            state.force_add_funds(playerIndex, 25);
-        };
-        ret[Card::CommunityChest_Gain45] = [](GameState& state, int playerIndex) {
-            state.force_add_funds(playerIndex, 40);
-        };
-        ret[Card::CommunityChest_GetOutOfJailFree] = [](GameState& state, int playerIndex) {
-            state.force_give_get_out_of_jail_free_card(playerIndex, DeckType::CommunityChest);
-        };
-        ret[Card::CommunityChest_GoToJail] = [](GameState& state, int playerIndex) {
-            state.force_go_to_jail(playerIndex);
-        };
-        ret[Card::CommunityChest_Pay100] = [](GameState& state, int playerIndex) {
-            state.force_subtract_funds(playerIndex, 100);
-        };
-        ret[Card::CommunityChest_Pay150] = [](GameState& state, int playerIndex) {
-            state.force_subtract_funds(playerIndex, 150);
-        };
-        ret[Card::CommunityChest_Pay50] = [](GameState& state, int playerIndex) {
-            state.force_subtract_funds(playerIndex, 50);
-        };
-        ret[Card::CommunityChest_Repairs] = [](GameState& state, int playerIndex) {
-            state.force_subtract_funds(playerIndex, calculate_building_repair_cost(state, playerIndex, 40, 115));
-        };
-        return ret;
-    } ();
-    auto const& effect = card_effects.at(card);
-    effect(state, playerIndex);
+    apply_card_effect(state, playerIndex, deck_type_of(card), card_effect(card));
+}
+
+void monopoly::apply_card_effect(GameState& state, int playerIndex, DeckType deckType, CardEffectData const& effect) {
+    switch (effect.kind) {
+    case CardEffectKind::AdvanceTo:
+        state.force_advance_to(playerIndex, static_cast<Space> (effect.space));
+        break;
+    case CardEffectKind::AdvanceToNearestRailroad: {
+        auto const pos = state.get_player_position(playerIndex);
+        auto const dest = nearest_space(pos, { Space::Railroad_1, Space::Railroad_2, Space::Railroad_3, Space::Railroad_4 });
+        state.force_advance_to_without_landing(playerIndex, dest);
+        auto const property = space_to_property(dest);
+        auto const owner = state.get_property_owner_index(property);
+        if (owner != Player::None) {
+            // Rent is doubled
+            state.force_transfer_funds(playerIndex, owner, 2 * state.calculate_rent(property));
+        }
+        else {
+            state.force_property_offer(playerIndex, property);
+        }
+        break;
+    }
+    case CardEffectKind::AdvanceToNearestUtility: {
+        auto const pos = state.get_player_position(playerIndex);
+        auto const dest = nearest_space(pos, { Space::Utility_1, Space::Utility_2 });
+        state.force_advance_to_without_landing(playerIndex, dest);
+        auto const property = space_to_property(dest);
+        auto const owner = state.get_property_owner_index(property);
+        if (owner != Player::None) {
+            // Pay 10 times a random roll
+            auto const roll = state.random_dice_roll();
+            auto const sum = roll.first + roll.second;
+            state.force_transfer_funds(playerIndex, owner, 10 * sum);
+        }
+        else {
+            state.force_property_offer(playerIndex, property);
+        }
+        break;
+    }
+    case CardEffectKind::Move:
+        state.force_advance(playerIndex, effect.amount);
+        break;
+    case CardEffectKind::Gain:
+        state.force_add_funds(playerIndex, effect.amount);
+        break;
+    case CardEffectKind::Pay:
+        state.force_subtract_funds(playerIndex, effect.amount);
+        break;
+    case CardEffectKind::PayEachPlayer:
+        for (auto p = 0; p < state.get_player_count(); ++p) {
+            state.force_transfer_funds(playerIndex, p, effect.amount);
+        }
+        break;
+    case CardEffectKind::CollectFromEachPlayer:
+        for (auto p = 0; p < state.get_player_count(); ++p) {
+            state.force_transfer_funds(p, playerIndex, effect.amount);
+        }
+        break;
+    case CardEffectKind::GetOutOfJailFree:
+        state.force_give_get_out_of_jail_free_card(playerIndex, deckType);
+        break;
+    case CardEffectKind::GoToJail:
+        state.force_go_to_jail(playerIndex);
+        break;
+    case CardEffectKind::Repairs:
+        state.force_subtract_funds(playerIndex, calculate_building_repair_cost(state, playerIndex, effect.perHouse, effect.perHotel));
+        break;
+    }
 }
@@ -1,8 +1,10 @@
 #pragma once
 
+#include "Random.h"
+
 #include <algorithm>
 #include <cassert>
-#include <functional>
+#include <cstdint>
 #include <random>
 #include <string>
 #include <vector>
@@ -97,11 +99,38 @@ namespace monopoly
         std::string effectText;
     };
 
-    using CardEffect = std::function<void(GameState& state, int playerIndex)>;
+    static constexpr int CardCount = static_cast<int> (Card::CommunityChest_Repairs) + 1;
+
+    enum class CardEffectKind : uint8_t
+    {
+        AdvanceTo,                  // advance to space, collecting the Go salary if passed
+        AdvanceToNearestRailroad,   // pay the owner twice the rent, or be offered the railroad
+        AdvanceToNearestUtility,    // pay the owner ten times a random roll, or be offered the utility
+        Move,                       // move amount spaces, negative amounts move backwards
+        Gain,                       // collect amount from the bank
+        Pay,                        // pay amount to the bank
+        PayEachPlayer,              // pay amount to every other player
+        CollectFromEachPlayer,      // collect amount from every other player
+        GetOutOfJailFree,           // keep the Get Out of Jail Free card of the deck the card was drawn from
+        GoToJail,
+        Repairs,                    // pay perHouse for each house and perHotel for each hotel
+    };
+
+    // What a card does, interpreted by apply_card_effect
+    struct CardEffectData
+    {
+        CardEffectKind kind;
+        int16_t amount = 0;
+        int8_t space = 0;   // index of the destination space, for AdvanceTo
+        int16_t perHouse = 0;
+        int16_t perHotel = 0;
+    };
 
     std::string to_string(DeckType deckType);
     CardData const& card_data(Card card);
+    CardEffectData const& card_effect(Card card);
     void apply_card_effect(GameState& state, int playerIndex, Card card);
+    void apply_card_effect(GameState& state, int playerIndex, DeckType deckType, CardEffectData const& effect);
 
     inline bool card_is_get_out_of_jail_free(Card card) {
         return (
@@ -121,59 +150,171 @@ namespace monopoly
         return Card::Chance_GetOutOfJailFree;
     }
 
+    // A deck of at most 16 cards from a single card type, drawn from the top
+    // and returned to the bottom
+    //
+    // The card order is packed into one 64-bit word, 4 bits per card (its
+    // offset from the first card of the deck type), with the top card in the
+    // lowest bits. Drawing, returning a card, and withdrawing the most recently
+    // drawn card are each a few shifts, and copying a deck never allocates.
+    //
+    // The deck also counts the cards at the top that nobody has seen since it
+    // was shuffled. Their order is hidden from the players, everything below
+    // them was drawn in plain sight.
     class Deck
     {
     public:
+        static constexpr int Capacity = 16;
+
         explicit Deck() {
         }
 
         explicit Deck(DeckType type)
+            : firstCard(static_cast<uint8_t> (type == DeckType::Chance ? ChanceCards.front() : CommunityChestCards.front()))
         {
-            if (type == DeckType::Chance) {
-                cards = ChanceCards;
-            }
-            else {
-                cards = CommunityChestCards;
+            auto const& cards = (type == DeckType::Chance) ? ChanceCards : CommunityChestCards;
+            assert(cards.size() <= Capacity);
+            for (auto card : cards) {
+                add_card(card);
             }
         }
+
+        Card top() const
+        {
+            assert(count > 0);
+            return to_card(bits & NibbleMask);
+        }
+
         Card draw()
         {
-            auto const card = cards.front();
-            cards.erase(cards.begin());
-            cards.push_back(card);
-            return card;
+            assert(count > 0);
+            auto const offset = bits & NibbleMask;
+            bits = (bits >> BitsPerCard) | (offset << shift(count - 1));
+            if (unseen > 0) {
+                --unseen;
+            }
+            return to_card(offset);
         }
 
         void stack_deck(DeckContainer const& sortedCardsToPutOnTop) {
+            auto cards = get_cards();
             auto it = begin(cards);
             for (auto desiredCard : sortedCardsToPutOnTop) {
                 auto desiredCardIt = std::find(it, cards.end(), desiredCard);
                 iter_swap(it++, desiredCardIt);
             }
+            set_cards(cards);
         }
 
         void add_card(Card card) {
-            cards.push_back(card);
+            assert(count < Capacity);
+            bits |= to_offset(card) << shift(count);
+            ++count;
         }
 
         void remove_card(Card card) {
-            auto const removedCardIt = std::find(cards.begin(), cards.end(), card);
-            if (removedCardIt != cards.end())
-                cards.erase(removedCardIt);
+            // A drawn card is at the bottom of the deck, so check there first
+            for (auto i = count - 1; i >= 0; --i) {
+                if (((bits >> shift(i)) & NibbleMask) == to_offset(card)) {
+                    remove_card_at(i);
+                    return;
+                }
+            }
         }
 
-        void shuffle(std::mt19937& rng)
+        void shuffle(Rng& rng)
         {
+            auto cards = get_cards();
             std::shuffle(cards.begin(), cards.end(), rng);
+            set_cards(cards);
+            unseen = count;
+        }
+
+        // Shuffle only the cards nobody has seen, as a player guessing at the order would. They are sorted
+        // first, so the result doesn't depend on their real order.
+        void shuffle_unseen(Rng& rng)
+        {
+            auto cards = get_cards();
+            std::sort(cards.begin(), cards.begin() + unseen);
+            std::shuffle(cards.begin(), cards.begin() + unseen, rng);
+            set_cards(cards);
+        }
+
+        // Cards at the top not drawn since the deck was shuffled
+        int unseen_count() const {
+            return unseen;
+        }
+
+        int size() const {
+            return count;
+        }
+
+        // The cards from top to bottom
+        DeckContainer get_cards() const {
+            DeckContainer cards;
+            cards.reserve(count);
+            for (auto i = 0; i < count; ++i) {
+                cards.push_back(to_card((bits >> shift(i)) & NibbleMask));
+            }
+            return cards;
+        }
+
+        // Mixes the order of the cards into one word, for hashing game states
+        uint64_t hash() const {
+            return bits ^ (static_cast<uint64_t> (count) * 0x9E3779B97F4A7C15ull) ^ (static_cast<uint64_t> (unseen) * 0xC2B2AE3D27D4EB4Full);
+        }
+
+        // Like hash, but the same whatever the order of the unseen cards
+        uint64_t observed_hash() const {
+            auto const seenBits = unseen < Capacity ? bits >> shift(unseen) : 0;
+            return seenBits ^ (static_cast<uint64_t> (count) * 0x9E3779B97F4A7C15ull) ^ (static_cast<uint64_t> (unseen) * 0xC2B2AE3D27D4EB4Full);
         }
 
         bool operator==(Deck const& rhs) const {
-            return cards == rhs.cards;
+            return bits == rhs.bits && count == rhs.count && unseen == rhs.unseen && firstCard == rhs.firstCard;
         }
         bool operator!=(Deck const& rhs) const {
             return !operator==(rhs);
         }
     private:
-        DeckContainer cards;
+        static constexpr int BitsPerCard = 4;
+        static constexpr uint64_t NibbleMask = 0xF;
+
+        static constexpr int shift(int position) {
+            return BitsPerCard * position;
+        }
+
+        Card to_card(uint64_t offset) const {
+            return static_cast<Card> (firstCard + offset);
+        }
+
+        uint64_t to_offset(Card card) const {
+            auto const offset = static_cast<int> (card) - firstCard;
+            assert(0 <= offset && offset < Capacity);
+            return static_cast<uint64_t> (offset);
+        }
+
+        void remove_card_at(int position) {
+            auto const below = bits & ((uint64_t{ 1 } << shift(position)) - 1);
+            auto const above = (position + 1 < Capacity) ? (bits >> shift(position + 1)) << shift(position) : 0;
+            bits = below | above;
+            --count;
+            if (position < unseen) {
+                --unseen;
+            }
+        }
+
+        void set_cards(DeckContainer const& cards) {
+            bits = 0;
+            count = 0;
+            for (auto card : cards) {
+                add_card(card);
+            }
+        }
+
+        uint64_t bits = 0;
+        uint8_t firstCard = 0;
+        int8_t count = 0;
+        int8_t unseen = 0;
     };
 }
\ No newline at end of file
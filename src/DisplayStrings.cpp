@@ -114,7 +114,7 @@ namespace {
     char const* lookup_key(PropertyGroup group) {
         switch (group) {
         case PropertyGroup::Brown: return "Brown";
-        case PropertyGroup::LightBlue: return "LightBluu";
+        case PropertyGroup::LightBlue: return "LightBlue";
         case PropertyGroup::Magenta: return "Magenta";
         case PropertyGroup::Orange: return "Orange";
         case PropertyGroup::Red: return "Red";
@@ -10,6 +10,8 @@ using namespace emscripten;
 #include "Game.h"
 #include "Input.h"
 #include "DisplayStrings.h"
+#include "GameEvents.h"
+#include "StateChanges.h"
 using namespace monopoly;
 
 // Allow "subclassing" IInterface from Javascript
@@ -17,11 +19,23 @@ class SimpleInterfaceWrapper : public wrapper<SimpleInterface> {
 public:
     EMSCRIPTEN_WRAPPER(SimpleInterfaceWrapper);
     GameSetup get_setup() {
-        return call<GameSetup>("get_setup");
+        // Narrate the game to stdout, which the web page shows as the game log
+        static TextEventSink textEventSink;
+        auto setup = call<GameSetup>("get_setup");
+        if (!setup.eventSink) {
+            setup.eventSink = &textEventSink;
+        }
+        return setup;
     }
-    void update(GameState state) {
+    void update(GameState const& state) {
         return call<void>("update", state);
     }
+    bool wants_changes() const {
+        return call<bool>("wants_changes");
+    }
+    void on_changes(std::vector<StateChange> const& changes) {
+        return call<void>("on_changes", changes);
+    }
 };
 
 EMSCRIPTEN_BINDINGS(Monopoly) {
@@ -29,7 +43,34 @@ EMSCRIPTEN_BINDINGS(Monopoly) {
     class_<IInterface>("IInterface")
         .function("get_setup", &IInterface::get_setup, pure_virtual())
         .function("update", &IInterface::update, pure_virtual())
+        .function("wants_changes", optional_override([](IInterface const& self) { return self.IInterface::wants_changes(); }))
+        .function("on_changes", optional_override([](IInterface& self, std::vector<StateChange> const& changes) { self.IInterface::on_changes(changes); }))
+        ;
+
+    // StateChanges.h
+    enum_<StateChange::Field>("StateChangeField")
+        .value("Turn", StateChange::Field::Turn)
+        .value("Phase", StateChange::Field::Phase)
+        .value("ActivePlayer", StateChange::Field::ActivePlayer)
+        .value("Funds", StateChange::Field::Funds)
+        .value("Position", StateChange::Field::Position)
+        .value("TurnsRemainingInJail", StateChange::Field::TurnsRemainingInJail)
+        .value("Eliminated", StateChange::Field::Eliminated)
+        .value("GetOutOfJailFreeCards", StateChange::Field::GetOutOfJailFreeCards)
+        .value("Owner", StateChange::Field::Owner)
+        .value("Mortgaged", StateChange::Field::Mortgaged)
+        .value("BuildingLevel", StateChange::Field::BuildingLevel)
+        .value("BankHouses", StateChange::Field::BankHouses)
+        .value("BankHotels", StateChange::Field::BankHotels)
+        .value("Auction", StateChange::Field::Auction)
+        .value("PendingTrade", StateChange::Field::PendingTrade)
+        ;
+    value_object<StateChange>("StateChange")
+        .field("field", &StateChange::field)
+        .field("index", &StateChange::index)
+        .field("value", &StateChange::value)
         ;
+    register_vector<StateChange>("VectorOfStateChange");
 
     class_<SimpleInterface, base<IInterface>>("SimpleInterface")
         .function("roll_dice", &SimpleInterfaceWrapper::roll_dice)
@@ -106,7 +147,30 @@ EMSCRIPTEN_BINDINGS(Monopoly) {
     function("card_to_string", select_overload<std::string(Card)>(&to_string));
     function("to_string", select_overload<std::string(TurnPhase)>(&to_string));
     function("card_data", &card_data);
-    function("apply_card_effect", &apply_card_effect);
+    enum_<CardEffectKind>("CardEffectKind")
+        .value("AdvanceTo", CardEffectKind::AdvanceTo)
+        .value("AdvanceToNearestRailroad", CardEffectKind::AdvanceToNearestRailroad)
+        .value("AdvanceToNearestUtility", CardEffectKind::AdvanceToNearestUtility)
+        .value("Move", CardEffectKind::Move)
+        .value("Gain", CardEffectKind::Gain)
+        .value("Pay", CardEffectKind::Pay)
+        .value("PayEachPlayer", CardEffectKind::PayEachPlayer)
+        .value("CollectFromEachPlayer", CardEffectKind::CollectFromEachPlayer)
+        .value("GetOutOfJailFree", CardEffectKind::GetOutOfJailFree)
+        .value("GoToJail", CardEffectKind::GoToJail)
+        .value("Repairs", CardEffectKind::Repairs)
+        ;
+
+    value_object<CardEffectData>("CardEffectData")
+        .field("kind", &CardEffectData::kind)
+        .field("amount", &CardEffectData::amount)
+        .field("space", &CardEffectData::space)
+        .field("perHouse", &CardEffectData::perHouse)
+        .field("perHotel", &CardEffectData::perHotel)
+        ;
+
+    function("card_effect", &card_effect);
+    function("apply_card_effect", select_overload<void(GameState&, int, Card)>(&apply_card_effect));
     function("card_is_get_out_of_jail_free", &card_is_get_out_of_jail_free);
     function("get_out_of_jail_free_card", &get_out_of_jail_free_card);
 
@@ -127,7 +191,7 @@ EMSCRIPTEN_BINDINGS(Monopoly) {
     constant ("BailCost", BailCost);
     constant ("GoSalary", GoSalary);
     constant ("MortgageInterestRate", MortgageInterestRate);
-    constant ("DeedTable", DeedTable);
+    constant ("DeedTable", std::vector<int>(DeedTable.begin(), DeedTable.end()));
     constant ("DeedTableColumns", DeedTableColumns);
 
     value_object<std::pair<int, int>>("PairOfInt")
@@ -234,6 +298,16 @@ EMSCRIPTEN_BINDINGS(Monopoly) {
         .value("Invalid", Space::Invalid)
         ;
 
+    class_<PropertySet>("PropertySet")
+        .constructor<>()
+        .function("size", &PropertySet::size)
+        .function("empty", &PropertySet::empty)
+        .function("contains", &PropertySet::contains)
+        .function("mask", &PropertySet::mask)
+        .function("at", &PropertySet::at)
+        .class_function("from_mask", &PropertySet::from_mask)
+        ;
+
     function("price_of_property", &price_of_property);
     function("property_group", &property_group);
     function("properties_in_group", &properties_in_group);
@@ -346,7 +420,10 @@ EMSCRIPTEN_BINDINGS(Monopoly) {
         .function("get_building_level", &GameState::get_building_level)
         .function("get_min_building_level_in_group", &GameState::get_min_building_level_in_group)
         .function("get_max_building_level_in_group", &GameState::get_max_building_level_in_group)
-        .function("get_building_levels", &GameState::get_building_levels)
+        .function("get_building_levels", optional_override([](GameState const& state) {
+            auto const& levels = state.get_building_levels();
+            return std::vector<int>(levels.begin(), levels.end());
+        }))
         .function("get_pending_trade_offer", &GameState::get_pending_trade_offer)
         .function("get_current_auction", &GameState::get_current_auction)
         .function("calculate_rent", &GameState::calculate_rent)
@@ -376,7 +453,12 @@ EMSCRIPTEN_BINDINGS(Monopoly) {
         .function("check_if_trade_is_valid", &GameState::check_if_trade_is_valid)
         .function("check_if_player_can_fulfill_promise", &GameState::check_if_player_can_fulfill_promise)
         .function("check_if_player_can_pay_closing_costs", &GameState::check_if_player_can_pay_closing_costs)
-        .function("player_action_roll", &GameState::player_action_roll)
+        .function("set_journaling", &GameState::set_journaling)
+        .function("is_journaling", &GameState::is_journaling)
+        .function("get_undo_depth", &GameState::get_undo_depth)
+        .function("undo", &GameState::undo)
+        .function("player_action_roll", select_overload<void(int)>(&GameState::player_action_roll))
+        .function("player_action_roll_loaded_dice", select_overload<void(int, std::pair<int, int>)>(&GameState::player_action_roll))
         .function("player_action_use_get_out_of_jail_free_card", &GameState::player_action_use_get_out_of_jail_free_card)
         .function("player_action_pay_bail", &GameState::player_action_pay_bail)
         .function("player_action_buy_property", &GameState::player_action_buy_property)
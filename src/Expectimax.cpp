@@ -0,0 +1,264 @@
+#include "Expectimax.h"
+#include "LandingProbabilities.h"
+using namespace monopoly;
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    // Longest run of greedy inputs between two rolls before the position is scored as it stands
+    constexpr int MaxInputsBetweenRolls = 256;
+    constexpr int AverageRoll = 7;
+
+    // Rent a deed can be expected to charge whoever lands on it
+    int expected_rent(GameState const& state, Property property) {
+        if (property_is_in_group(property, PropertyGroup::Utility)) {
+            if (state.get_property_is_mortgaged(property)) {
+                return 0;
+            }
+            auto const multiplier = state.get_properties_owned_in_group(property) == 2 ? 10 : 4;
+            return multiplier * AverageRoll;
+        }
+        return state.calculate_rent(property);
+    }
+}
+
+ExpectimaxSolver::ExpectimaxSolver(ExpectimaxOptions options)
+    : options(std::move(options))
+    , state()
+    , policy()
+    , memo()
+{
+}
+
+bool ExpectimaxSolver::handles(GameState const& state) {
+    if (state.is_game_over()) {
+        return false;
+    }
+    auto const playerIndex = state.get_controlling_player_index();
+    switch (state.get_turn_phase()) {
+    case TurnPhase::WaitingForBuyPropertyInput:
+        return state.check_if_player_is_allowed_to_auction_property(playerIndex);
+    case TurnPhase::WaitingForRoll:
+        return state.check_if_player_is_allowed_to_pay_bail(playerIndex)
+            || state.check_if_player_is_allowed_to_use_get_out_jail_free_card(playerIndex);
+    default:
+        return false;
+    }
+}
+
+std::optional<Input> ExpectimaxSolver::best_action(GameState const& rootState) {
+    if (!handles(rootState)) {
+        return {};
+    }
+    state = rootState;
+    state.set_event_sink(nullptr);
+    // Put the cards nobody has seen in an order that only depends on which cards they are, so that nothing
+    // the players can't see carries into the solution
+    state.force_reseed(0);
+    state.force_shuffle_unseen_cards();
+    state.set_journaling(true);
+
+    std::vector<Input> inputs;
+    decisions(inputs);
+    auto const playerIndex = state.get_controlling_player_index();
+    auto best = inputs.front();
+    auto bestValue = -std::numeric_limits<double>::infinity();
+    for (auto const& input : inputs) {
+        double v;
+        if (std::holds_alternative<RollInput>(input)) {
+            v = chance(options.depth)[playerIndex];
+        }
+        else {
+            apply_input(state, playerIndex, input);
+            v = value(options.depth)[playerIndex];
+            undo_to(0);
+        }
+        if (v > bestValue) {
+            bestValue = v;
+            best = input;
+        }
+    }
+    return best;
+}
+
+void ExpectimaxSolver::decisions(std::vector<Input>& inputs) const {
+    auto const playerIndex = state.get_controlling_player_index();
+    inputs.clear();
+    if (state.get_turn_phase() == TurnPhase::WaitingForBuyPropertyInput) {
+        if (state.check_if_player_is_allowed_to_buy_property(playerIndex)) {
+            inputs.push_back(BuyPropertyInput{});
+        }
+        inputs.push_back(AuctionPropertyInput{});
+        return;
+    }
+    inputs.push_back(RollInput{});
+    if (state.check_if_player_is_allowed_to_pay_bail(playerIndex)) {
+        inputs.push_back(PayBailInput{});
+    }
+    if (state.check_if_player_is_allowed_to_use_get_out_jail_free_card(playerIndex)) {
+        inputs.push_back(UseGetOutOfJailFreeCardInput{});
+    }
+}
+
+// Plays greedy inputs until the next roll, a decision to maximise, or the end of the game
+ExpectimaxSolver::Values ExpectimaxSolver::value(int depth) {
+    auto const start = state.get_undo_depth();
+    Values result{};
+    auto resolved = false;
+    for (auto i = 0; i < MaxInputsBetweenRolls && !resolved; ++i) {
+        if (state.is_game_over()) {
+            break;
+        }
+        auto const playerIndex = state.get_controlling_player_index();
+        if (handles(state)) {
+            std::vector<Input> inputs;
+            decisions(inputs);
+            auto const mark = state.get_undo_depth();
+            auto bestValue = -std::numeric_limits<double>::infinity();
+            for (auto const& input : inputs) {
+                Values v;
+                if (std::holds_alternative<RollInput>(input)) {
+                    v = chance(depth);
+                }
+                else {
+                    apply_input(state, playerIndex, input);
+                    v = value(depth);
+                    undo_to(mark);
+                }
+                if (v[playerIndex] > bestValue) {
+                    bestValue = v[playerIndex];
+                    result = v;
+                }
+            }
+            resolved = true;
+        }
+        else if (state.get_turn_phase() == TurnPhase::WaitingForRoll) {
+            result = chance(depth);
+            resolved = true;
+        }
+        else {
+            apply_input(state, playerIndex, policy.decide(state, playerIndex));
+        }
+    }
+    if (!resolved) {
+        result = evaluate();
+    }
+    undo_to(start);
+    return result;
+}
+
+// Averages the value after each of the 21 distinct dice outcomes
+ExpectimaxSolver::Values ExpectimaxSolver::chance(int depth) {
+    if (depth == 0) {
+        return evaluate();
+    }
+    auto const key = MemoKey{ state.compact_hash(), depth };
+    auto const it = memo.find(key);
+    if (it != memo.end()) {
+        return it->second;
+    }
+
+    auto const playerIndex = state.get_controlling_player_index();
+    Values result{};
+    for (auto d1 = 1; d1 <= 6; ++d1) {
+        for (auto d2 = d1; d2 <= 6; ++d2) {
+            auto const weight = (d1 == d2 ? 1.0 : 2.0) / 36.0;
+            auto const v = roll(playerIndex, { d1, d2 }, depth - 1);
+            for (auto p = 0; p < MaxPlayerCount; ++p) {
+                result[p] += weight * v[p];
+            }
+        }
+    }
+
+    if (memo.size() >= options.memoCapacity) {
+        memo.clear();
+    }
+    memo.emplace(key, result);
+    return result;
+}
+
+// Value after rolling the dice. A roll that draws a card nobody has seen is averaged over each card it could
+// be, all equally likely, by putting each one on top of the deck in turn.
+ExpectimaxSolver::Values ExpectimaxSolver::roll(int playerIndex, std::pair<int, int> dice, int depth) {
+    auto const mark = state.get_undo_depth();
+    // Chance comes first: going back three spaces from Chance can land on Community Chest, but not the other way
+    DeckType const deckTypes[] = { DeckType::Chance, DeckType::CommunityChest };
+    int const unseen[] = { state.get_deck(DeckType::Chance).unseen_count(), state.get_deck(DeckType::CommunityChest).unseen_count() };
+
+    state.player_action_roll(playerIndex, dice);
+    auto drawn = -1;
+    for (auto i = 0; i < 2 && drawn < 0; ++i) {
+        if (state.get_deck(deckTypes[i]).unseen_count() < unseen[i]) {
+            drawn = i;
+        }
+    }
+    if (drawn < 0) {
+        auto const v = value(depth);
+        undo_to(mark);
+        return v;
+    }
+    undo_to(mark);
+
+    // Stacking the deck is outside of any action so it isn't undone, the top card is put back by hand
+    auto const deckType = deckTypes[drawn];
+    auto const cards = state.get_deck(deckType).get_cards();
+    auto const count = unseen[drawn];
+    Values result{};
+    for (auto c = 0; c < count; ++c) {
+        state.force_stack_deck(deckType, { cards[c] });
+        state.player_action_roll(playerIndex, dice);
+        auto const v = value(depth);
+        undo_to(mark);
+        state.force_stack_deck(deckType, { cards.front() });
+        for (auto p = 0; p < MaxPlayerCount; ++p) {
+            result[p] += v[p] / count;
+        }
+    }
+    return result;
+}
+
+// Each player's share of the assets in play, counting the rent their deeds can be expected to collect
+ExpectimaxSolver::Values ExpectimaxSolver::evaluate() const {
+    auto const& landing = LandingProbabilities::get();
+    Values values{};
+    auto const playerCount = state.get_player_count();
+    auto const opponents = state.get_players_remaining_count() - 1;
+    auto total = 0.0;
+    for (auto p = 0; p < playerCount; ++p) {
+        if (state.get_player_eliminated(p)) {
+            continue;
+        }
+        auto rent = 0.0;
+        for (auto property : state.get_player_deeds(p)) {
+            rent += expected_rent(state, property) * landing.per_turn(property_to_space(property));
+        }
+        auto const assets = state.get_net_worth(p) + static_cast<double> (options.rentHorizonTurns) * opponents * rent;
+        values[p] = std::max(0.0, assets);
+        total += values[p];
+    }
+    for (auto p = 0; p < playerCount; ++p) {
+        values[p] = total > 0.0 ? values[p] / total : 0.0;
+    }
+    return values;
+}
+
+void ExpectimaxSolver::undo_to(int undoDepth) {
+    while (state.get_undo_depth() > undoDepth) {
+        state.undo();
+    }
+}
+
+ExpectimaxPolicy::ExpectimaxPolicy(ExpectimaxOptions options)
+    : solver(std::move(options))
+    , greedy()
+{
+}
+
+Input ExpectimaxPolicy::decide(GameState const& state, int playerIndex) {
+    if (auto const input = solver.best_action(state)) {
+        return *input;
+    }
+    return greedy.decide(state, playerIndex);
+}
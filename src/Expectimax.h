@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Policies.h"
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace monopoly
+{
+    struct ExpectimaxOptions
+    {
+        // Rolls to look ahead, counting every player's rolls. Each roll multiplies the work by about 20,
+        // a depth of 1 takes a few hundred microseconds
+        int depth = 1;
+        // Turns of rent a deed is expected to keep collecting from each opponent after the horizon
+        int rentHorizonTurns = 20;
+        // The memo is cleared when it grows past this many positions
+        std::size_t memoCapacity = 1 << 16;
+    };
+
+    // Depth-limited expectimax for decisions that only matter over the next few rolls
+    //
+    // Buying or auctioning a property, and leaving jail by rolling, paying bail or
+    // using a card, are solved by expanding the 21 distinct dice outcomes
+    // (weighted by their 36 orderings) for a fixed number of rolls. The same
+    // decisions further down are maximised for whoever makes them, any other
+    // decision is made by the greedy policy, and positions at the horizon are
+    // scored by net worth plus the rent each player's deeds can be expected to
+    // collect, going by the long run landing probabilities. A roll that draws a
+    // card nobody has seen yet is averaged over every card it could be, so the
+    // solver never looks at the real order of the decks.
+    //
+    // Values of positions before a roll are memoised by a compact hash of the
+    // state and the rolls left to look ahead, and kept between decisions.
+    class ExpectimaxSolver
+    {
+    public:
+        explicit ExpectimaxSolver(ExpectimaxOptions options = {});
+
+        // True if the game is waiting on a decision the solver handles
+        static bool handles(GameState const& state);
+        // The best input for the controlling player, empty unless handles(state)
+        std::optional<Input> best_action(GameState const& state);
+
+    private:
+        using Values = std::array<double, MaxPlayerCount>;
+
+        using MemoKey = std::pair<uint64_t, int>; // compact hash and depth
+        struct MemoKeyHash
+        {
+            std::size_t operator()(MemoKey const& key) const {
+                return static_cast<std::size_t> (key.first ^ (static_cast<uint64_t> (key.second) * 0x9E3779B97F4A7C15ull));
+            }
+        };
+
+        Values value(int depth);
+        Values chance(int depth);
+        Values roll(int playerIndex, std::pair<int, int> dice, int depth);
+        Values evaluate() const;
+        void decisions(std::vector<Input>& inputs) const;
+        void undo_to(int undoDepth);
+
+        ExpectimaxOptions const options;
+        GameState state;
+        GreedyPolicy policy;
+        std::unordered_map<MemoKey, Values, MemoKeyHash> memo;
+    };
+
+    // Plays greedily, except for the decisions the expectimax solver handles
+    class ExpectimaxPolicy final : public IPolicy
+    {
+    public:
+        explicit ExpectimaxPolicy(ExpectimaxOptions options = {});
+        Input decide(GameState const& state, int playerIndex) final;
+
+    private:
+        ExpectimaxSolver solver;
+        GreedyPolicy greedy;
+    };
+}
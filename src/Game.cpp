@@ -3,7 +3,6 @@
 using namespace monopoly;
 
 #include<chrono>
-#include<iostream>
 using namespace std::chrono_literals;
 
 
@@ -148,18 +147,27 @@ Game::Game(IInterface* interface)
     : interface(interface)
     , setup(interface->get_setup())
     , currentCycle(0)
+    , startTime()
     , state(setup)
 {
     start();
 }
 
-GameState Game::get_state() const {
+GameState const& Game::get_state() const {
     return state;
 }
 
+std::shared_ptr<GameState const> Game::snapshot() const {
+    if (!cachedSnapshot) {
+        cachedSnapshot = std::make_shared<GameState const>(state);
+    }
+    return cachedSnapshot;
+}
+
 void Game::set_state(GameState newState) {
     currentCycle = 0;
     std::swap(state, newState);
+    cachedSnapshot.reset();
 }
 
 void Game::reset() {
@@ -169,6 +177,15 @@ void Game::reset() {
 
 void Game::process() {
     process_inputs();
+    // The clock is only read here, so that copies of the state played out by searches stay deterministic
+    if (setup.maxWallTime.count() > 0 && !state.is_game_over()
+        && std::chrono::steady_clock::now() - startTime >= setup.maxWallTime) {
+        state.force_adjudicate(Adjudication::WallTime);
+    }
+    cachedSnapshot.reset();
+    if (interface->wants_changes()) {
+        publish_changes();
+    }
     interface->update(state);
     currentCycle++;
 }
@@ -184,18 +201,40 @@ void Game::process_inputs() {
     }
 }
 
+void monopoly::apply_input(GameState& state, int playerIndex, Input const& input) {
+    std::visit([&state, playerIndex](auto&& i) { ::process_input(state, playerIndex, i); }, input);
+}
+
 void Game::process_input(int playerIndex, Input const& input) {
-    std::visit([=](auto&& i) { ::process_input(state, playerIndex, i); }, input);
+    apply_input(state, playerIndex, input);
+}
+
+void Game::publish_changes() {
+    changes.clear();
+    diff_states(publishedState, state, changes);
+    if (!changes.empty()) {
+        interface->on_changes(changes);
+        publishedState = state;
+    }
 }
 
 void Game::start() {
-    std::cout << "Starting a new game" << std::endl;
+    if (setup.eventSink) {
+        setup.eventSink->on_event(GameStarted{});
+    }
     GameState newState(interface->get_setup());
     currentCycle = 0;
+    startTime = std::chrono::steady_clock::now();
     std::swap(state, newState);
+    cachedSnapshot.reset();
+    if (interface->wants_changes()) {
+        publishedState = state;
+    }
     interface->update(state);
 }
 
 void Game::stop() {
-    std::cout << "Game over" << std::endl;
+    if (setup.eventSink) {
+        setup.eventSink->on_event(GameStopped{});
+    }
 }
@@ -1,7 +1,9 @@
 #pragma once
 #include"GameState.h"
 #include"Input.h"
+#include"StateChanges.h"
 
+#include<chrono>
 #include<condition_variable>
 #include<future>
 #include<memory>
@@ -14,25 +16,34 @@
 namespace monopoly
 {
     class IInterface;
+
+    // Apply a player's input to the state, inputs the player isn't allowed to make are ignored
+    void apply_input(GameState& state, int playerIndex, Input const& input);
+
     class Game
     {
     public:
         ~Game();
         Game(IInterface* interface);
 
-        GameState get_state() const;
+        // The same object for as long as the game exists, set_state and reset replace its contents
+        GameState const& get_state() const;
+        // A shared, immutable copy of the current state, shared by every caller until the state changes
+        std::shared_ptr<GameState const> snapshot() const;
         void set_state(GameState state);
 
         // Game is started over with the same setup
         void reset();
 
-        // Process inputs until further player intervention is required
+        // Process inputs until further player intervention is required, and
+        // adjudicate the game once it has run for longer than GameSetup::maxWallTime
         void process();
 
     private:
         void process_inputs();
 
         void process_input(int playerIndex, Input const& input);
+        void publish_changes();
 
         void start();
         void stop();
@@ -41,6 +52,11 @@ namespace monopoly
         GameSetup const setup;
 
         int currentCycle;
+        std::chrono::steady_clock::time_point startTime;
         GameState state;
+        mutable std::shared_ptr<GameState const> cachedSnapshot;
+        // The state as of the last published changes, only kept if the interface wants changes
+        GameState publishedState;
+        std::vector<StateChange> changes;
     };
 }
@@ -0,0 +1,174 @@
+#include "GameEvents.h"
+#include "DisplayStrings.h"
+#include "Player.h"
+using namespace monopoly;
+
+namespace
+{
+    struct TextNarrator
+    {
+        std::ostream& out;
+
+        void operator()(GameStarted const&) const {
+            out << "Starting a new game\n";
+        }
+        void operator()(GameStopped const&) const {
+            out << "Game over\n";
+        }
+        void operator()(RolledDice const& e) const {
+            out << player_name(e.player) << " rolled the dice\n";
+        }
+        void operator()(Rolled const& e) const {
+            out << player_name(e.player) << " rolled [" << e.roll.first << "] [" << e.roll.second << "]\n";
+        }
+        void operator()(UsedGetOutOfJailFreeCard const& e) const {
+            out << player_name(e.player) << " used a get out of jail free card\n";
+            out << player_name(e.player) << " used a " << to_string(e.deckType) << " Get Out of Jail Free card\n";
+        }
+        void operator()(PaidBail const& e) const {
+            out << player_name(e.player) << " paid bail\n";
+        }
+        void operator()(BoughtProperty const& e) const {
+            out << player_name(e.player) << " bought " << to_string(e.property) << "\n";
+        }
+        void operator()(DeclinedProperty const& e) const {
+            out << player_name(e.player) << " declined to buy " << to_string(e.property) << "\n";
+        }
+        void operator()(Mortgaged const& e) const {
+            out << player_name(e.player) << " mortgaged " << to_string(e.property) << "\n";
+        }
+        void operator()(Unmortgaged const& e) const {
+            out << player_name(e.player) << " unmortgaged " << to_string(e.property) << "\n";
+        }
+        void operator()(BoughtBuilding const& e) const {
+            out << player_name(e.player) << " bought a building on " << to_string(e.property) << "\n";
+        }
+        void operator()(SoldBuilding const& e) const {
+            out << player_name(e.player) << " sold a building on " << to_string(e.property) << "\n";
+        }
+        void operator()(SoldAllBuildings const& e) const {
+            out << player_name(e.player) << " sold all bulding in color group " << to_string(e.group) << "\n";
+        }
+        void operator()(PlacedBid const& e) const {
+            out << player_name(e.player) << " bid $" << e.amount << "\n";
+        }
+        void operator()(DeclinedBid const& e) const {
+            out << player_name(e.player) << " has declined to bid\n";
+        }
+        void operator()(OfferedTrade const& e) const {
+            if (e.counterOffer) {
+                out << player_name(e.offeringPlayer) << " made a counter-offer to " << e.consideringPlayer << "\n";
+            }
+            else {
+                out << player_name(e.offeringPlayer) << " offered a trade to " << e.consideringPlayer << "\n";
+            }
+        }
+        void operator()(AcceptedTrade const& e) const {
+            out << player_name(e.offeringPlayer) << " accepted the offer from " << e.consideringPlayer << "\n";
+        }
+        void operator()(DeclinedTrade const& e) const {
+            out << player_name(e.player) << " rejected the offer\n";
+        }
+        void operator()(EndedTurn const& e) const {
+            out << player_name(e.player) << " ended their turn\n";
+        }
+        void operator()(Resigned const& e) const {
+            out << player_name(e.player) << " declared bankruptcy! \n";
+            if (e.creditor != Player::None) {
+                out << player_name(e.player) << " must hand over all assets to " << player_name(e.creditor) << "\n";
+            }
+            else {
+                out << player_name(e.player) << " will have their properties put up for auction\n";
+            }
+        }
+        void operator()(SetFunds const& e) const {
+            out << player_name(e.player) << " has $" << e.funds << "\n";
+        }
+        void operator()(Collected const& e) const {
+            out << player_name(e.player) << " collects $" << e.amount << "\n";
+        }
+        void operator()(Paid const& e) const {
+            out << player_name(e.player) << " pays $" << e.amount << "\n";
+        }
+        void operator()(PaidPlayer const& e) const {
+            out << player_name(e.player) << " pays $" << e.amount << " to " << player_name(e.recipient) << "\n";
+        }
+        void operator()(PaidRent const& e) const {
+            out << player_name(e.player) << " pays $" << e.amount << " to " << player_name(e.owner) << "\n";
+        }
+        void operator()(WentToJail const& e) const {
+            out << player_name(e.player) << " went to jail!\n";
+        }
+        void operator()(LeftJail const& e) const {
+            out << player_name(e.player) << " rolled doubles and left jail\n";
+        }
+        void operator()(StuckInJail const& e) const {
+            out << player_name(e.player) << " is stuck in jail\n";
+        }
+        void operator()(MustPayBail const& e) const {
+            out << player_name(e.player) << " must pay fine\n";
+        }
+        void operator()(RolledThreeDoubles const& e) const {
+            out << player_name(e.player) << " went to jail for rolling 3 doubles in a row\n";
+        }
+        void operator()(ExtraRoll const& e) const {
+            out << player_name(e.player) << " gets an extra roll for rolling doubles\n";
+        }
+        void operator()(Advanced const& e) const {
+            out << player_name(e.player) << " advanced " << e.distance << " spaces\n";
+        }
+        void operator()(PassedGo const& e) const {
+            out << player_name(e.player) << " passed " << to_string(Space::Go) << "\n";
+        }
+        void operator()(Landed const& e) const {
+            out << player_name(e.player) << " landed on " << to_string(e.space) << "\n";
+        }
+        void operator()(DrewCard const& e) const {
+            out << player_name(e.player) << " draws a " << to_string(e.deckType) << " card \n";
+            out << "\t" << card_data(e.card).effectText << "\n";
+        }
+        void operator()(PaidTax const& e) const {
+            auto const taxName = (e.space == Space::IncomeTax) ? "income tax" : "luxury tax";
+            out << player_name(e.player) << " pays " << taxName << " (" << e.amount << ")\n";
+        }
+        void operator()(OfferedProperty const& e) const {
+            out << player_name(e.player) << ": Buy " << to_string(e.property) << " or let it go to auction?\n";
+        }
+        void operator()(IncurredDebt const& e) const {
+            out << player_name(e.debtor) << ": You are in debt";
+            if (e.creditor != Player::None) {
+                out << " to " << player_name(e.creditor);
+            }
+            out << ". Manage property or trade to come up with the funds OR declare bankruptcy!\n";
+        }
+        void operator()(AuctionStarted const& e) const {
+            out << "Auctioning property " << to_string(e.property) << "\n";
+        }
+        void operator()(AuctionStanding const& e) const {
+            out << to_string(e.property) << " going to " << player_name(e.highestBidder) << " for $" << e.highestBid << "\n";
+        }
+        void operator()(BidRequested const& e) const {
+            out << player_name(e.player) << ": Bid or decline?\n";
+        }
+        void operator()(CannotAffordBid const& e) const {
+            out << player_name(e.player) << " can't afford to bid more than " << e.highestBid << "\n";
+        }
+        void operator()(WonAuction const& e) const {
+            out << player_name(e.player) << " won the auction of " << to_string(e.property) << " for $" << e.amount << "\n";
+        }
+        void operator()(ReceivedProperty const& e) const {
+            out << player_name(e.player) << " received " << to_string(e.property) << "\n";
+        }
+        void operator()(AuctionWinnerBankrupt const& e) const {
+            out << player_name(e.player) << " won the bid, but declared bankruptcy, " << to_string(e.property) << " goes back up for auction\n";
+        }
+        void operator()(Adjudicated const& e) const {
+            out << (e.reason == Adjudication::TurnLimit ? "Turn limit reached, " : "Time limit reached, ")
+                << player_name(e.winner) << " wins with the highest net worth\n";
+        }
+    };
+}
+
+void TextEventSink::on_event(GameEvent const& event) {
+    std::visit(TextNarrator{ out }, event);
+}
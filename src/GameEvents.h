@@ -0,0 +1,335 @@
+#pragma once
+
+#include "Board.h"
+#include "Cards.h"
+
+#include <iostream>
+#include <utility>
+#include <variant>
+
+namespace monopoly {
+
+    // Game events
+    //
+    // Everything that happens in a game is reported to an optional event sink
+    // as one of these compact records. Nothing is formatted unless a sink
+    // chooses to, so a game without a sink pays nothing for narration.
+
+    // Why a game that was still going was decided on net worth
+    enum class Adjudication {
+        None,
+        TurnLimit, // GameSetup::maxTurns turns were played
+        WallTime,  // the game ran for longer than GameSetup::maxWallTime
+    };
+
+    // A new game was started
+    struct GameStarted {
+    };
+
+    // The game was stopped
+    struct GameStopped {
+    };
+
+    // The player chose to roll the dice, the outcome follows as Rolled
+    struct RolledDice {
+        int player;
+    };
+
+    // The dice came up with this roll
+    struct Rolled {
+        int player;
+        std::pair<int, int> roll;
+    };
+
+    struct UsedGetOutOfJailFreeCard {
+        int player;
+        DeckType deckType;
+    };
+
+    struct PaidBail {
+        int player;
+    };
+
+    struct BoughtProperty {
+        int player;
+        Property property;
+    };
+
+    // The player declined to buy the property they landed on, so it will be auctioned
+    struct DeclinedProperty {
+        int player;
+        Property property;
+    };
+
+    struct Mortgaged {
+        int player;
+        Property property;
+    };
+
+    struct Unmortgaged {
+        int player;
+        Property property;
+    };
+
+    struct BoughtBuilding {
+        int player;
+        Property property;
+    };
+
+    struct SoldBuilding {
+        int player;
+        Property property;
+    };
+
+    struct SoldAllBuildings {
+        int player;
+        PropertyGroup group;
+    };
+
+    struct PlacedBid {
+        int player;
+        int amount;
+    };
+
+    struct DeclinedBid {
+        int player;
+    };
+
+    // A trade (or a counter-offer to a pending trade) was proposed
+    struct OfferedTrade {
+        int offeringPlayer;
+        int consideringPlayer;
+        bool counterOffer;
+    };
+
+    // The offering player accepted by proposing the reciprocal of the pending trade
+    struct AcceptedTrade {
+        int offeringPlayer;
+        int consideringPlayer;
+    };
+
+    struct DeclinedTrade {
+        int player;
+    };
+
+    struct EndedTurn {
+        int player;
+    };
+
+    // The player resigned; their assets go to the creditor, or are auctioned by the bank if the creditor is Player::None
+    struct Resigned {
+        int player;
+        int creditor;
+    };
+
+    struct SetFunds {
+        int player;
+        int funds;
+    };
+
+    // The player collected money from the bank
+    struct Collected {
+        int player;
+        int amount;
+    };
+
+    // The player paid money to the bank
+    struct Paid {
+        int player;
+        int amount;
+    };
+
+    // The player paid money to another player (other than rent)
+    struct PaidPlayer {
+        int player;
+        int recipient;
+        int amount;
+    };
+
+    struct PaidRent {
+        int player;
+        int owner;
+        Property property;
+        int amount;
+    };
+
+    struct WentToJail {
+        int player;
+    };
+
+    // The player rolled doubles while in jail
+    struct LeftJail {
+        int player;
+    };
+
+    struct StuckInJail {
+        int player;
+    };
+
+    // The player has no turns remaining in jail and must pay bail
+    struct MustPayBail {
+        int player;
+    };
+
+    struct RolledThreeDoubles {
+        int player;
+    };
+
+    struct ExtraRoll {
+        int player;
+    };
+
+    struct Advanced {
+        int player;
+        int distance;
+    };
+
+    struct PassedGo {
+        int player;
+    };
+
+    struct Landed {
+        int player;
+        Space space;
+    };
+
+    struct DrewCard {
+        int player;
+        DeckType deckType;
+        Card card;
+    };
+
+    // Income tax or luxury tax, depending on the space
+    struct PaidTax {
+        int player;
+        Space space;
+        int amount;
+    };
+
+    // The player must decide to buy the property or let it go to auction
+    struct OfferedProperty {
+        int player;
+        Property property;
+    };
+
+    // The debtor must come up with the amount owed to the creditor, or the bank if the creditor is Player::None
+    struct IncurredDebt {
+        int debtor;
+        int creditor;
+        int amount;
+    };
+
+    struct AuctionStarted {
+        Property property;
+    };
+
+    // Reported whenever the auction is waiting on the next bidder
+    struct AuctionStanding {
+        Property property;
+        int highestBidder;
+        int highestBid;
+    };
+
+    struct BidRequested {
+        int player;
+    };
+
+    // The bidder is removed from the auction because they can't raise the bid
+    struct CannotAffordBid {
+        int player;
+        int highestBid;
+    };
+
+    struct WonAuction {
+        int player;
+        Property property;
+        int amount;
+    };
+
+    // The auction winner paid for and received the property
+    struct ReceivedProperty {
+        int player;
+        Property property;
+    };
+
+    // The auction winner went bankrupt paying for the property, so it goes back up for auction
+    struct AuctionWinnerBankrupt {
+        int player;
+        Property property;
+    };
+
+    // The game was stopped and won by the player with the highest net worth, everyone else is eliminated
+    struct Adjudicated {
+        Adjudication reason;
+        int winner;
+    };
+
+    using GameEvent = std::variant<
+        GameStarted,
+        GameStopped,
+        RolledDice,
+        Rolled,
+        UsedGetOutOfJailFreeCard,
+        PaidBail,
+        BoughtProperty,
+        DeclinedProperty,
+        Mortgaged,
+        Unmortgaged,
+        BoughtBuilding,
+        SoldBuilding,
+        SoldAllBuildings,
+        PlacedBid,
+        DeclinedBid,
+        OfferedTrade,
+        AcceptedTrade,
+        DeclinedTrade,
+        EndedTurn,
+        Resigned,
+        SetFunds,
+        Collected,
+        Paid,
+        PaidPlayer,
+        PaidRent,
+        WentToJail,
+        LeftJail,
+        StuckInJail,
+        MustPayBail,
+        RolledThreeDoubles,
+        ExtraRoll,
+        Advanced,
+        PassedGo,
+        Landed,
+        DrewCard,
+        PaidTax,
+        OfferedProperty,
+        IncurredDebt,
+        AuctionStarted,
+        AuctionStanding,
+        BidRequested,
+        CannotAffordBid,
+        WonAuction,
+        ReceivedProperty,
+        AuctionWinnerBankrupt,
+        Adjudicated
+    >;
+
+    class IGameEventSink
+    {
+    public:
+        virtual ~IGameEventSink() = default;
+        virtual void on_event(GameEvent const& event) = 0;
+    };
+
+    // Narrates events as text, one line per event (the classic command line output)
+    class TextEventSink final : public IGameEventSink
+    {
+    public:
+        explicit TextEventSink(std::ostream& out = std::cout)
+            : out(out) {
+        }
+        void on_event(GameEvent const& event) final;
+
+    private:
+        std::ostream& out;
+    };
+}
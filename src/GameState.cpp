@@ -1,20 +1,23 @@
 #include"GameState.h"
 #include"Board.h"
-#include"DisplayStrings.h"
+#include"Input.h"
 using namespace monopoly;
 
 #include<algorithm>
-#include<iostream>
-#include<numeric>
 
 GameState::GameState(GameSetup setup)
-    : rng()
+    : eventSink(setup.eventSink)
+    , zobrist(0)
+    , rng(setup.rng)
     , phase(TurnPhase::WaitingForRoll)
     , bank()
     , decks(init_decks(setup))
     , players(init_players(setup))
     , doublesStreak(0)
     , lastDiceRoll(0, 0)
+    , propertyOwners()
+    , buildingLevels()
+    , rentCache()
     , pendingTradeAgreement()
     , pendingDebtSettlements()
     , currentAuction()
@@ -23,16 +26,43 @@ GameState::GameState(GameSetup setup)
     , pendingPurchaseDecision(false)
     , pendingRoll(true)
     , activePlayerIndex(Player::p1)
+    , maxTurns(setup.maxTurns)
+    , adjudication(Adjudication::None)
 {
-    std::seed_seq seedSeq(setup.seed.begin(), setup.seed.end());
-    rng = std::mt19937(seedSeq);
-    decks[DeckType::CommunityChest].shuffle(rng);
-    decks[DeckType::Chance].shuffle(rng);
+    propertyOwners.fill(Player::None);
+    rng.seed(setup.seed);
+    deck(DeckType::CommunityChest).shuffle(rng);
+    deck(DeckType::Chance).shuffle(rng);
+    zobrist = recompute_hash();
+}
+
+void GameState::set_event_sink(IGameEventSink* sink) {
+    eventSink = sink;
+}
+
+IGameEventSink* GameState::get_event_sink() const {
+    return eventSink;
 }
 
 bool GameState::is_game_over() const {
     return phase == TurnPhase::GameOver;
 }
+
+Adjudication GameState::get_adjudication() const {
+    return adjudication;
+}
+
+int GameState::get_winner_index() const {
+    if (phase != TurnPhase::GameOver) {
+        return Player::None;
+    }
+    for (auto p = 0; p < get_player_count(); ++p) {
+        if (!players[p].eliminated) {
+            return p;
+        }
+    }
+    return Player::None;
+}
 int GameState::get_turn() const {
     return turn;
 }
@@ -73,7 +103,7 @@ int GameState::get_active_player_index() const {
     return activePlayerIndex;
 }
 
-std::set<Property> GameState::get_player_deeds(int playerIndex) const {
+PropertySet GameState::get_player_deeds(int playerIndex) const {
     return players[playerIndex].deeds;
 }
 
@@ -81,6 +111,10 @@ std::set<DeckType> GameState::get_player_get_out_of_jail_free_cards(int playerIn
     return players[playerIndex].getOutOfJailFreeCards;
 }
 
+Deck const& GameState::get_deck(DeckType deckType) const {
+    return decks[static_cast<int> (deckType)];
+}
+
 int GameState::get_controlling_player_index() const {
     switch (phase) {
         case TurnPhase::WaitingForTradeOfferResponse:
@@ -116,48 +150,36 @@ int GameState::get_next_player_index(int playerIndex) const {
 
 int GameState::get_net_worth(int playerIndex) const {
     auto const& p = players[playerIndex];
-    std::vector<int> values;
     int netWorth = p.funds;
-    // Add property values
-    std::transform(begin(p.deeds), end(p.deeds), std::back_inserter(values),
-        [this](Property p) -> int { return mortgagedProperties.count(p) ? mortgage_value_of_property(p) : price_of_property(p); });
-    netWorth = std::accumulate(begin(values), end(values), netWorth);
-    values.clear();
-    // Add building values
-    std::transform(begin(p.deeds), end(p.deeds), std::back_inserter(values),
-        [this](Property p) -> int { return get_building_level(p) * price_per_house_on_property(p); });
-    netWorth = std::accumulate(begin(values), end(values), netWorth);
+    for (auto property : p.deeds) {
+        // Add property values
+        netWorth += mortgagedProperties.contains(property) ? mortgage_value_of_property(property) : price_of_property(property);
+        // Add building values
+        netWorth += get_building_level(property) * price_per_house_on_property(property);
+    }
     return netWorth;
 }
 
 int GameState::get_property_owner_index(Property property) const {
     if (property == Property::Invalid) {
-        return -1;
-    }
-    for (auto p = 0; p < players.size(); ++p) {
-        if (players[p].deeds.count(property))
-            return p;
+        return Player::None;
     }
-    return Player::None;
+    return propertyOwners[static_cast<int> (property)];
 }
 
 bool GameState::get_property_is_mortgaged(Property property) const {
-    return mortgagedProperties.count(property) > 0;
+    return mortgagedProperties.contains(property);
 }
 
 int GameState::get_properties_owned_in_group(Property property) const {
     auto const owner = get_property_owner_index(property);
-    auto const ownedGroupCount = owner
-        ? get_properties_owned_in_group_by_player(owner, property_group(property))
-        : 0;
-    return ownedGroupCount;
+    return get_properties_owned_in_group_by_player(owner, property_group(property));
 }
 
 int GameState::get_properties_owned_in_group_by_player(int playerIndex, PropertyGroup group) const {
     if (playerIndex == Player::None)
         return 0;
-    auto const& deeds = players[playerIndex].deeds;
-    return std::count_if(deeds.begin(), deeds.end(), [group](Property property) { return property_is_in_group(property, group); });
+    return (players[playerIndex].deeds & properties_in_group(group)).size();
 }
 
 TurnPhase GameState::get_turn_phase() const {
@@ -165,11 +187,10 @@ TurnPhase GameState::get_turn_phase() const {
 }
 
 int GameState::get_building_level(Property property) const {
-    auto const buildingLevelIt = buildingLevels.find(property);
-    if (buildingLevelIt != buildingLevels.end()) {
-        return buildingLevelIt->second;
+    if (property == Property::Invalid) {
+        return 0;
     }
-    return 0;
+    return buildingLevels[static_cast<int> (property)];
 }
 
 int GameState::get_min_building_level_in_group(PropertyGroup group) const {
@@ -188,7 +209,7 @@ int GameState::get_max_building_level_in_group(PropertyGroup group) const {
     return max;
 }
 
-std::map<Property, int> const& GameState::get_building_levels() const {
+BuildingLevels const& GameState::get_building_levels() const {
     return buildingLevels;
 }
 
@@ -201,8 +222,20 @@ Auction GameState::get_current_auction() const {
 }
 
 int GameState::calculate_rent(Property property) const {
+    if (property == Property::Invalid) {
+        return 0;
+    }
+    auto const rent = rentCache[static_cast<int> (property)];
+    assert(rent == compute_rent(property));
+    if (property_is_in_group(property, PropertyGroup::Utility)) {
+        return rent * (lastDiceRoll.first + lastDiceRoll.second);
+    }
+    return rent;
+}
+
+int GameState::compute_rent(Property property) const {
     auto const ownerIndex = get_property_owner_index(property);
-    if (ownerIndex == Player::None) {
+    if (ownerIndex == Player::None || get_property_is_mortgaged(property)) {
         return 0;
     }
     auto const group = property_group(property);
@@ -212,12 +245,12 @@ int GameState::calculate_rent(Property property) const {
         return rent_price_of_railroad(ownedDeedsInGroup);
     }
     else if (group == PropertyGroup::Utility) {
-        return rent_price_of_utility(ownedDeedsInGroup, lastDiceRoll);
+        return rent_price_of_utility(ownedDeedsInGroup, { 1, 0 });
     }
     else { // group is real estate
-        auto const buildingLevelIt = buildingLevels.find(property);
-        if (buildingLevelIt != buildingLevels.end() && buildingLevelIt->second > 0) {
-            return rent_price_of_improved_real_estate(property, buildingLevelIt->second);
+        auto const buildingLevel = get_building_level(property);
+        if (buildingLevel > 0) {
+            return rent_price_of_improved_real_estate(property, buildingLevel);
         }
         else if (properties_in_group(group).size() == ownedDeedsInGroup) {
             return 2 * rent_price_of_real_estate(property);
@@ -228,6 +261,12 @@ int GameState::calculate_rent(Property property) const {
     }
 }
 
+void GameState::update_rent_cache(PropertyGroup group) {
+    for (auto property : properties_in_group(group)) {
+        rentCache[static_cast<int> (property)] = compute_rent(property);
+    }
+}
+
 int GameState::calculate_closing_costs_on_sale(Property property) const {
     if (mortgagedProperties.count(property)) {
         return mortgage_value_of_property(property) * MortgageInterestRate;
@@ -242,25 +281,225 @@ int GameState::calculate_liquid_assets_value(int playerIndex) const {
     return p.funds + calculate_liquid_value_of_deeds (p.deeds) + calculate_liquid_value_of_buildings (p.deeds);
 }
 
-int GameState::calculate_liquid_value_of_deeds(std::set<Property> deeds) const {
-    std::vector<int> values;
-    std::transform(begin(deeds), end(deeds), std::back_inserter(values),
-        [this](Property p) -> int { return mortgagedProperties.count(p) ? 0 : mortgage_value_of_property(p); });
-    return std::accumulate(begin(values), end(values), 0);
+int GameState::calculate_liquid_value_of_deeds(PropertySet deeds) const {
+    int value = 0;
+    for (auto property : deeds - mortgagedProperties) {
+        value += mortgage_value_of_property(property);
+    }
+    return value;
 }
 
-int GameState::calculate_liquid_value_of_buildings(std::set<Property> properties) const {
-    std::vector<int> values;
-    std::transform(begin(properties), end(properties), std::back_inserter(values),
-        [this](Property p) -> int { return get_building_level(p) * sell_price_per_house_on_property(p); });
-    return std::accumulate(begin(values), end(values), 0);
+int GameState::calculate_liquid_value_of_buildings(PropertySet properties) const {
+    int value = 0;
+    for (auto property : properties) {
+        value += get_building_level(property) * sell_price_per_house_on_property(property);
+    }
+    return value;
 }
 
 int GameState::calculate_liquid_value_of_promise(Promise promise) const {
     return promise.cash + calculate_liquid_value_of_deeds(promise.deeds);
 }
 
+namespace
+{
+    // FNV-1a over whole values
+    struct HashMixer {
+        uint64_t hash = 14695981039346656037ull;
+
+        void mix(uint64_t value) {
+            hash = (hash ^ value) * 1099511628211ull;
+        }
+    };
+
+    constexpr uint64_t splitmix64(uint64_t x) {
+        x += 0x9e3779b97f4a7c15ull;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+        return x ^ (x >> 31);
+    }
+
+    constexpr int PhaseCount = static_cast<int> (TurnPhase::GameOver) + 1;
+
+    // Players and decks are keyed by hashing their contents with a per-player or per-deck key, since funds and
+    // deck orders have too many values for a table
+    struct ZobristKeys {
+        std::array<std::array<uint64_t, MaxPlayerCount + 1>, PropertyCount> owners{}; // last column is the bank
+        std::array<uint64_t, PropertyCount> mortgaged{};
+        std::array<std::array<uint64_t, HotelLevel + 1>, PropertyCount> buildings{};
+        std::array<uint64_t, PhaseCount> phases{};
+        std::array<uint64_t, MaxPlayerCount> activePlayers{};
+        std::array<uint64_t, MaxPlayerCount> players{};
+        std::array<uint64_t, 2> decks{};
+    };
+
+    constexpr ZobristKeys make_zobrist_keys() {
+        ZobristKeys keys;
+        uint64_t seed = 0;
+        for (auto& row : keys.owners) {
+            for (auto& key : row) {
+                key = splitmix64(++seed);
+            }
+        }
+        for (auto& key : keys.mortgaged) {
+            key = splitmix64(++seed);
+        }
+        for (auto& row : keys.buildings) {
+            for (auto& key : row) {
+                key = splitmix64(++seed);
+            }
+        }
+        for (auto& key : keys.phases) {
+            key = splitmix64(++seed);
+        }
+        for (auto& key : keys.activePlayers) {
+            key = splitmix64(++seed);
+        }
+        for (auto& key : keys.players) {
+            key = splitmix64(++seed);
+        }
+        for (auto& key : keys.decks) {
+            key = splitmix64(++seed);
+        }
+        return keys;
+    }
+
+    constexpr ZobristKeys Zobrist = make_zobrist_keys();
+}
+
+uint64_t GameState::hash() const {
+#ifdef MONOPOLY_VERIFY_HASH
+    assert(zobrist == recompute_hash());
+#endif
+    return zobrist;
+}
+
+uint64_t GameState::recompute_hash() const {
+    auto h = flow_key();
+    for (auto p = 0; p < get_player_count(); ++p) {
+        h ^= player_key(p);
+    }
+    for (auto i = 0; i < PropertyCount; ++i) {
+        h ^= property_key(static_cast<Property> (i));
+    }
+    for (auto deckType : { DeckType::Chance, DeckType::CommunityChest }) {
+        h ^= deck_key(deckType);
+    }
+    return h;
+}
+
+uint64_t GameState::observed_hash() const {
+    auto h = hash();
+    for (auto deckType : { DeckType::Chance, DeckType::CommunityChest }) {
+        h ^= deck_key(deckType);
+        h ^= splitmix64(Zobrist.decks[static_cast<int> (deckType)] ^ get_deck(deckType).observed_hash());
+    }
+    return h;
+}
+
+uint64_t GameState::player_key(int playerIndex) const {
+    auto const& player = players[playerIndex];
+    auto const cards = static_cast<uint64_t> (player.getOutOfJailFreeCards.count(DeckType::Chance))
+        | static_cast<uint64_t> (player.getOutOfJailFreeCards.count(DeckType::CommunityChest)) << 1;
+    return splitmix64(Zobrist.players[playerIndex]
+        ^ static_cast<uint32_t> (player.funds)
+        ^ static_cast<uint64_t> (player.position) << 32
+        ^ static_cast<uint64_t> (player.turnsRemainingInJail) << 40
+        ^ static_cast<uint64_t> (player.eliminated) << 48
+        ^ cards << 52);
+}
+
+uint64_t GameState::property_key(Property property) const {
+    auto const i = static_cast<int> (property);
+    auto const owner = propertyOwners[i] == Player::None ? MaxPlayerCount : propertyOwners[i];
+    return Zobrist.owners[i][owner]
+        ^ (mortgagedProperties.contains(property) ? Zobrist.mortgaged[i] : 0)
+        ^ Zobrist.buildings[i][buildingLevels[i]];
+}
+
+uint64_t GameState::deck_key(DeckType deckType) const {
+    return splitmix64(Zobrist.decks[static_cast<int> (deckType)] ^ get_deck(deckType).hash());
+}
+
+uint64_t GameState::flow_key() const {
+    return Zobrist.phases[static_cast<int> (phase)] ^ Zobrist.activePlayers[activePlayerIndex];
+}
+
+void GameState::set_phase(TurnPhase newPhase) {
+    zobrist ^= flow_key();
+    phase = newPhase;
+    zobrist ^= flow_key();
+}
+
+void GameState::set_active_player(int playerIndex) {
+    zobrist ^= flow_key();
+    activePlayerIndex = playerIndex;
+    zobrist ^= flow_key();
+}
+
+uint64_t GameState::compact_hash() const {
+    HashMixer h;
+    h.mix(hash());
+    h.mix(doublesStreak);
+    h.mix(lastDiceRoll.first * 8 + lastDiceRoll.second);
+    h.mix((pendingRoll ? 1 : 0) | (pendingPurchaseDecision ? 2 : 0) | (pendingTradeAgreement ? 4 : 0));
+    h.mix(pendingDebtSettlements.size());
+    h.mix(propertiesPendingAuction.size());
+    h.mix(currentAuction.highestBid);
+    for (auto bidder : currentAuction.biddingOrder) {
+        h.mix(bidder);
+    }
+    return h.hash;
+}
+
+static_assert(FeatureLayout::PhaseCount == static_cast<int> (TurnPhase::GameOver) + 1, "FeatureLayout is missing turn phases");
+
+void GameState::encode_features(float* out) const {
+    using L = FeatureLayout;
+    std::fill(out, out + L::Stride, 0.0f);
+    auto const controllingPlayerIndex = get_controlling_player_index();
+    for (auto p = 0; p < get_player_count(); ++p) {
+        auto const& player = players[p];
+        out[L::Position + p * NumberOfSpaces + space_to_index(player.position)] = 1.0f;
+        out[L::Funds + p] = player.funds * L::FundsScale;
+        out[L::PlayerFlags + p * 3 + 0] = player.eliminated ? 0.0f : 1.0f;
+        out[L::PlayerFlags + p * 3 + 1] = p == activePlayerIndex ? 1.0f : 0.0f;
+        out[L::PlayerFlags + p * 3 + 2] = p == controllingPlayerIndex ? 1.0f : 0.0f;
+        if (player.turnsRemainingInJail > 0) {
+            out[L::Jail + p * MaxJailTurns + player.turnsRemainingInJail - 1] = 1.0f;
+        }
+        for (auto deckType : player.getOutOfJailFreeCards) {
+            out[L::Cards + p * 2 + static_cast<int> (deckType)] = 1.0f;
+        }
+    }
+    for (auto i = 0; i < PropertyCount; ++i) {
+        auto const owner = propertyOwners[i] == Player::None ? MaxPlayerCount : propertyOwners[i];
+        out[L::Owner + i * (MaxPlayerCount + 1) + owner] = 1.0f;
+        out[L::Buildings + i * (HotelLevel + 1) + buildingLevels[i]] = 1.0f;
+    }
+    for (auto property : mortgagedProperties) {
+        out[L::Mortgaged + static_cast<int> (property)] = 1.0f;
+    }
+    out[L::Phase + static_cast<int> (phase)] = 1.0f;
+    for (auto deckType : { DeckType::Chance, DeckType::CommunityChest }) {
+        auto const& d = get_deck(deckType);
+        if (d.size() > 0) {
+            auto const firstCard = deckType == DeckType::Chance ? ChanceCards.front() : CommunityChestCards.front();
+            auto const offset = static_cast<int> (d.top()) - static_cast<int> (firstCard);
+            out[L::DeckTop + static_cast<int> (deckType) * Deck::Capacity + offset] = 1.0f;
+        }
+    }
+    out[L::DoublesStreak + std::min(doublesStreak, L::MaxDoublesStreak)] = 1.0f;
+}
+
+void GameState::encode_features(GameState const* const* states, std::size_t count, float* out) {
+    for (std::size_t i = 0; i < count; ++i) {
+        states[i]->encode_features(out + i * FeatureLayout::Stride);
+    }
+}
+
 std::pair<int, int> GameState::random_dice_roll() {
+    journal(JournalRng);
     std::uniform_int_distribution<int> rollDie(1, 6);
     lastDiceRoll = std::pair<int, int>{ rollDie(rng), rollDie(rng) };
     return lastDiceRoll;
@@ -618,15 +857,229 @@ bool GameState::check_if_player_can_pay_closing_costs(int playerIndex, Promise l
     return liquidValue >= 0;
 }
 
+void GameState::legal_actions(int playerIndex, ActionBuffer& actions) const {
+    actions.clear();
+    if (phase == TurnPhase::GameOver || get_controlling_player_index() != playerIndex) {
+        return;
+    }
+    auto const& player = players[playerIndex];
+
+    if (check_if_player_is_allowed_to_roll(playerIndex)) {
+        actions.push_back(RollInput{});
+    }
+    if (check_if_player_is_allowed_to_use_get_out_jail_free_card(playerIndex)) {
+        for (auto deckType : player.getOutOfJailFreeCards) {
+            actions.push_back(UseGetOutOfJailFreeCardInput{ deckType });
+        }
+    }
+    if (check_if_player_is_allowed_to_pay_bail(playerIndex)) {
+        actions.push_back(PayBailInput{});
+    }
+    if (check_if_player_is_allowed_to_buy_property(playerIndex)) {
+        actions.push_back(BuyPropertyInput{});
+    }
+    if (check_if_player_is_allowed_to_auction_property(playerIndex)) {
+        actions.push_back(AuctionPropertyInput{});
+    }
+    if (phase == TurnPhase::WaitingForBids) {
+        for (auto increment : actions.bidIncrements) {
+            auto const amount = currentAuction.highestBid + increment;
+            if (check_if_player_is_allowed_to_bid(playerIndex, amount)) {
+                actions.push_back(BidInput{ amount });
+            }
+        }
+    }
+    if (check_if_player_is_allowed_to_decline_bid(playerIndex)) {
+        actions.push_back(DeclineBidInput{});
+    }
+    if (phase == TurnPhase::WaitingForTradeOfferResponse) {
+        auto const acceptance = reciprocal_trade(*pendingTradeAgreement);
+        if (check_if_trade_is_valid(acceptance)) {
+            actions.push_back(OfferTradeInput{ acceptance.offer, acceptance.consideringPlayer, acceptance.consideration });
+        }
+    }
+    if (check_if_player_is_allowed_to_decline_trade(playerIndex)) {
+        actions.push_back(DeclineTradeInput{});
+    }
+    for (auto property : player.deeds) {
+        if (check_if_player_is_allowed_to_mortgage(playerIndex, property)) {
+            actions.push_back(MortgagePropertiesInput{ { property } });
+        }
+        if (check_if_player_is_allowed_to_unmortgage(playerIndex, property)) {
+            actions.push_back(UnmortgagePropertiesInput{ { property } });
+        }
+        if (check_if_player_is_allowed_to_buy_building(playerIndex, property)) {
+            actions.push_back(BuyBuildingInput{ property });
+        }
+        if (check_if_player_is_allowed_to_sell_building(playerIndex, property)) {
+            actions.push_back(SellBuildingInput{ property });
+        }
+    }
+    for (auto g = 0; g <= static_cast<int> (PropertyGroup::Blue); ++g) {
+        auto const group = static_cast<PropertyGroup> (g);
+        if (check_if_player_is_allowed_to_sell_all_buildings(playerIndex, group)) {
+            actions.push_back(SellAllBuildingsInput{ group });
+        }
+    }
+    if (check_if_player_is_allowed_to_end_turn(playerIndex)) {
+        actions.push_back(EndTurnInput{});
+    }
+    if (check_if_player_is_allowed_to_resign(playerIndex)) {
+        actions.push_back(ResignInput{});
+    }
+}
+
+void GameState::set_journaling(bool enabled) {
+    undoJournal = UndoJournal{};
+    undoJournal.enabled = enabled;
+}
+
+bool GameState::is_journaling() const {
+    return undoJournal.enabled;
+}
+
+int GameState::get_undo_depth() const {
+    return static_cast<int> (undoJournal.records.size());
+}
+
+void GameState::undo() {
+    auto& j = undoJournal;
+    assert(!j.records.empty());
+    auto const record = j.records.back();
+    j.records.pop_back();
+    zobrist = record.hash;
+
+    if (record.parts & JournalFlow) {
+        auto const& flow = j.flows.back();
+        turn = flow.turn;
+        phase = flow.phase;
+        doublesStreak = flow.doublesStreak;
+        lastDiceRoll = flow.lastDiceRoll;
+        pendingPurchaseDecision = flow.pendingPurchaseDecision;
+        pendingRoll = flow.pendingRoll;
+        activePlayerIndex = flow.activePlayerIndex;
+        adjudication = flow.adjudication;
+        j.flows.pop_back();
+    }
+    if (record.parts & JournalBoard) {
+        auto const& board = j.boards.back();
+        bank = board.bank;
+        propertyOwners = board.propertyOwners;
+        mortgagedProperties = board.mortgagedProperties;
+        buildingLevels = board.buildingLevels;
+        rentCache = board.rentCache;
+        j.boards.pop_back();
+    }
+    for (auto i = popcount(record.players); i > 0; --i) {
+        auto& saved = j.players.back();
+        players[saved.first] = std::move(saved.second);
+        j.players.pop_back();
+    }
+    if (record.parts & JournalDecks) {
+        decks = j.decks.back();
+        j.decks.pop_back();
+    }
+    if (record.parts & JournalRng) {
+        rng = j.rngs[--j.rngCount];
+    }
+    if (record.parts & JournalTrade) {
+        pendingTradeAgreement = std::move(j.trades.back());
+        j.trades.pop_back();
+    }
+    if (record.parts & JournalDebts) {
+        pendingDebtSettlements = std::move(j.debts.back());
+        j.debts.pop_back();
+    }
+    if (record.parts & JournalAuction) {
+        currentAuction = std::move(j.auctions.back());
+        j.auctions.pop_back();
+    }
+    if (record.parts & JournalAuctionSale) {
+        pendingAuctionSale = j.auctionSales.back();
+        j.auctionSales.pop_back();
+    }
+    if (record.parts & JournalAuctionQueue) {
+        propertiesPendingAuction = std::move(j.auctionQueues.back());
+        j.auctionQueues.pop_back();
+    }
+}
+
+GameState::JournalScope GameState::journal_action() {
+    if (undoJournal.enabled && undoJournal.actionDepth == 0) {
+        // Every action resolves the game state, so the flow is always saved
+        undoJournal.records.push_back({ JournalFlow, 0, zobrist });
+        undoJournal.flows.push_back({ turn, phase, doublesStreak, lastDiceRoll, pendingPurchaseDecision, pendingRoll, activePlayerIndex, adjudication });
+    }
+    return JournalScope(undoJournal);
+}
+
+void GameState::journal(JournalPart part) {
+    auto& j = undoJournal;
+    if (!j.enabled || j.actionDepth == 0 || (j.records.back().parts & part)) {
+        return;
+    }
+    j.records.back().parts |= part;
+    switch (part) {
+    case JournalFlow:
+        break;
+    case JournalBoard:
+        j.boards.push_back({ bank, propertyOwners, mortgagedProperties, buildingLevels, rentCache });
+        break;
+    case JournalDecks:
+        j.decks.push_back(decks);
+        break;
+    case JournalRng:
+        if (j.rngCount < j.rngs.size()) {
+            j.rngs[j.rngCount] = rng;
+        }
+        else {
+            j.rngs.push_back(rng);
+        }
+        ++j.rngCount;
+        break;
+    case JournalTrade:
+        j.trades.push_back(pendingTradeAgreement);
+        break;
+    case JournalDebts:
+        j.debts.push_back(pendingDebtSettlements);
+        break;
+    case JournalAuction:
+        j.auctions.push_back(currentAuction);
+        break;
+    case JournalAuctionSale:
+        j.auctionSales.push_back(pendingAuctionSale);
+        break;
+    case JournalAuctionQueue:
+        j.auctionQueues.push_back(propertiesPendingAuction);
+        break;
+    }
+}
+
+void GameState::journal_player(int playerIndex) {
+    auto& j = undoJournal;
+    auto const bit = static_cast<uint16_t> (1u << playerIndex);
+    if (!j.enabled || j.actionDepth == 0 || (j.records.back().players & bit)) {
+        return;
+    }
+    j.records.back().players |= bit;
+    j.players.emplace_back(playerIndex, players[playerIndex]);
+}
+
 void GameState::player_action_roll(int playerIndex) {
-    std::cout << player_name(playerIndex) << " rolled the dice" << std::endl;
-    force_roll(playerIndex, random_dice_roll());
+    auto const scope = journal_action();
+    player_action_roll(playerIndex, random_dice_roll());
+}
+
+void GameState::player_action_roll(int playerIndex, std::pair<int, int> roll) {
+    auto const scope = journal_action();
+    emit(RolledDice{ playerIndex });
+    force_roll(playerIndex, roll);
     resolve_game_state();
 }
 
 void GameState::player_action_use_get_out_of_jail_free_card(int playerIndex, DeckType preferredDeckType) {
+    auto const scope = journal_action();
     assert(check_if_player_is_allowed_to_use_get_out_jail_free_card(playerIndex));
-    std::cout << player_name(playerIndex) << " used a get out of jail free card" << std::endl;
     auto& player = players[playerIndex];
     if (player.turnsRemainingInJail == 0)
         return;
@@ -636,23 +1089,25 @@ void GameState::player_action_use_get_out_of_jail_free_card(int playerIndex, Dec
         ? preferredDeckType
         : *player.getOutOfJailFreeCards.begin();
 
-    std::cout << player_name(playerIndex) << " used a " << to_string(usedDeckType) << " Get Out of Jail Free card" << std::endl;
+    emit(UsedGetOutOfJailFreeCard{ playerIndex, usedDeckType });
     force_return_get_out_of_jail_free_card(playerIndex, usedDeckType);
     force_leave_jail(playerIndex);
     resolve_game_state();
 }
 
 void GameState::player_action_pay_bail(int playerIndex) {
+    auto const scope = journal_action();
     assert(check_if_player_is_allowed_to_pay_bail(playerIndex));
-    std::cout << player_name(playerIndex) << " paid bail" << std::endl;
+    emit(PaidBail{ playerIndex });
     force_pay_bail(playerIndex);
     resolve_game_state();
 }
 
 void GameState::player_action_buy_property(int playerIndex) {
+    auto const scope = journal_action();
     assert(check_if_player_is_allowed_to_buy_property(playerIndex));
     auto const landedOnProperty = space_to_property(players[playerIndex].position);
-    std::cout << player_name(playerIndex) << " bought " << to_string(landedOnProperty) << std::endl;
+    emit(BoughtProperty{ playerIndex, landedOnProperty });
     force_subtract_funds(playerIndex, price_of_property(landedOnProperty));
     force_give_deed(playerIndex, landedOnProperty);
     pendingPurchaseDecision = false;
@@ -660,56 +1115,65 @@ void GameState::player_action_buy_property(int playerIndex) {
 }
 
 void GameState::player_action_auction_property(int playerIndex) {
+    auto const scope = journal_action();
     assert(check_if_player_is_allowed_to_auction_property(playerIndex));
     auto const landedOnProperty = space_to_property(players[playerIndex].position);
-    std::cout << player_name(playerIndex) << " declined to buy " << to_string(landedOnProperty) << std::endl;
+    emit(DeclinedProperty{ playerIndex, landedOnProperty });
+    journal(JournalAuctionQueue);
     propertiesPendingAuction.push(landedOnProperty);
     pendingPurchaseDecision = false;
     resolve_game_state();
 }
 
 void GameState::player_action_mortgage(int playerIndex, Property property) {
+    auto const scope = journal_action();
     assert(check_if_player_is_allowed_to_mortgage(playerIndex, property));
-    std::cout << player_name(playerIndex) << " mortgaged " << to_string(property) << std::endl;
+    emit(Mortgaged{ playerIndex, property });
     force_set_mortgaged(property, true);
     force_add_funds(playerIndex, mortgage_value_of_property(property));
     resolve_game_state();
 }
 
 void GameState::player_action_unmortgage(int playerIndex, Property property) {
+    auto const scope = journal_action();
     assert(check_if_player_is_allowed_to_unmortgage(playerIndex, property));
-    std::cout << player_name(playerIndex) << " unmortgaged " << to_string(property) << std::endl;
+    emit(Unmortgaged{ playerIndex, property });
     force_set_mortgaged(property, false);
     force_subtract_funds(playerIndex, unmortgage_price_of_property(property));
     resolve_game_state();
 }
 
 void GameState::player_action_buy_building(int playerIndex, Property property) {
+    auto const scope = journal_action();
     assert(check_if_player_is_allowed_to_buy_building(playerIndex, property));
-    std::cout << player_name(playerIndex) << " bought a building on " << to_string(property) << std::endl;
+    emit(BoughtBuilding{ playerIndex, property });
     force_add_building(property);
     force_subtract_funds(playerIndex, price_per_house_on_property(property));
     resolve_game_state();
 }
 
 void GameState::player_action_sell_building(int playerIndex, Property property) {
+    auto const scope = journal_action();
     assert(check_if_player_is_allowed_to_sell_building(playerIndex, property));
-    std::cout << player_name(playerIndex) << " sold a building on " << to_string(property) << std::endl;
+    emit(SoldBuilding{ playerIndex, property });
     force_remove_building(property);
     force_add_funds(playerIndex, sell_price_per_house_on_property(property));
     resolve_game_state();
 }
 
-void GameState::player_action_sell_all_buildings(int playerIndex, PropertyGroup group) { 
+void GameState::player_action_sell_all_buildings(int playerIndex, PropertyGroup group) {
+    auto const scope = journal_action();
     assert(check_if_player_is_allowed_to_sell_all_buildings(playerIndex, group));
-    std::cout << player_name(playerIndex) << " sold all bulding in color group " << to_string(group) << std::endl;
+    emit(SoldAllBuildings{ playerIndex, group });
     force_sell_all_buildings(playerIndex, group);
     resolve_game_state();
 }
 
 void GameState::player_action_bid(int playerIndex, int amount) {
+    auto const scope = journal_action();
     assert(check_if_player_is_allowed_to_bid (playerIndex, amount));
-    std::cout << player_name(playerIndex) << " bid $" << amount << std::endl;
+    emit(PlacedBid{ playerIndex, amount });
+    journal(JournalAuction);
     currentAuction.highestBid = amount;
     currentAuction.biddingOrder.erase(currentAuction.biddingOrder.begin ());
     currentAuction.biddingOrder.push_back(playerIndex);
@@ -717,49 +1181,52 @@ void GameState::player_action_bid(int playerIndex, int amount) {
 }
 
 void GameState::player_action_decline_bid(int playerIndex) {
+    auto const scope = journal_action();
     assert(check_if_player_is_allowed_to_decline_bid (playerIndex));
-    std::cout << player_name(playerIndex) << " has declined to bid" << std::endl;
+    emit(DeclinedBid{ playerIndex });
+    journal(JournalAuction);
     currentAuction.biddingOrder.erase(currentAuction.biddingOrder.begin ());
     resolve_game_state();
 }
 
 void GameState::player_action_offer_trade(Trade trade) {
+    auto const scope = journal_action();
     assert(check_if_trade_is_valid (trade));
+    journal(JournalTrade);
 
     if (pendingTradeAgreement && trades_are_reciprocal(trade, *pendingTradeAgreement)) {
         pendingTradeAgreement = {};
-        std::cout << player_name(trade.offeringPlayer) << " accepted the offer from " << trade.consideringPlayer << std::endl;
+        emit(AcceptedTrade{ trade.offeringPlayer, trade.consideringPlayer });
         force_trade(trade);
     }
     else {
-        if (pendingTradeAgreement) {
-            std::cout << player_name(trade.offeringPlayer) << " made a counter-offer to " << trade.consideringPlayer << std::endl;
-        }
-        else {
-            std::cout << player_name(trade.offeringPlayer) << " offered a trade to " << trade.consideringPlayer << std::endl;
-        }
+        emit(OfferedTrade{ trade.offeringPlayer, trade.consideringPlayer, pendingTradeAgreement.has_value() });
         pendingTradeAgreement = trade;
     }
     resolve_game_state();
 }
 
 void GameState::player_action_decline_trade(int playerIndex) {
+    auto const scope = journal_action();
     assert(check_if_player_is_allowed_to_decline_trade(playerIndex));
-    std::cout << player_name(playerIndex) << " rejected the offer" << std::endl;
+    emit(DeclinedTrade{ playerIndex });
+    journal(JournalTrade);
     pendingTradeAgreement = {};
     resolve_game_state();
 }
 
 void GameState::player_action_end_turn(int playerIndex) {
+    auto const scope = journal_action();
     assert(check_if_player_is_allowed_to_end_turn(playerIndex));
-    std::cout << player_name(playerIndex) << " ended their turn" << std::endl;
+    emit(EndedTurn{ playerIndex });
     force_start_turn(get_next_player_index());
     resolve_game_state();
 }
 
 void GameState::player_action_resign(int resigneeIndex) {
+    auto const scope = journal_action();
     assert(check_if_player_is_allowed_to_resign(resigneeIndex));
-    std::cout << player_name(resigneeIndex) << " declared bankruptcy! " << std::endl;
+    journal(JournalDebts);
     std::optional<int> creditor;
     for (auto debtIt = pendingDebtSettlements.begin(); debtIt != pendingDebtSettlements.end();) {
         if (debtIt->debtor == resigneeIndex) {
@@ -771,17 +1238,22 @@ void GameState::player_action_resign(int resigneeIndex) {
         }
         ++debtIt;
     }
+    emit(Resigned{ resigneeIndex, creditor.value_or(Player::None) });
     if (creditor) {
-        std::cout << player_name(resigneeIndex) << " must hand over all assets to " << player_name(*creditor) << std::endl;
         force_bankrupt_by_player(resigneeIndex, *creditor);
     }
     else {
-        std::cout << player_name(resigneeIndex) << " will have their properties put up for auction" << std::endl;
 		force_bankrupt_by_bank(resigneeIndex);
     }
     if (check_if_player_is_allowed_to_auction_property (resigneeIndex)) {
         player_action_auction_property(resigneeIndex);
     }
+    else if (pendingPurchaseDecision && activePlayerIndex == resigneeIndex) {
+        // Resigned over a debt before getting to decide on the property they landed on
+        journal(JournalAuctionQueue);
+        propertiesPendingAuction.push(space_to_property(players[resigneeIndex].position));
+        pendingPurchaseDecision = false;
+    }
     if (check_if_player_is_allowed_to_decline_trade (resigneeIndex)) {
         player_action_decline_trade(resigneeIndex);
     }
@@ -792,14 +1264,25 @@ void GameState::player_action_resign(int resigneeIndex) {
         force_finish_turn();
         force_start_turn(get_next_player_index());
     }
+    journal_player(resigneeIndex);
+    zobrist ^= player_key(resigneeIndex);
     players[resigneeIndex].eliminated = true;
+    zobrist ^= player_key(resigneeIndex);
 	resolve_game_state();
 }
 
+void GameState::force_reseed(unsigned seed) {
+    rng.seed(seed);
+}
+
 void GameState::force_start_turn(int playerIndex) {
+    if (maxTurns > 0 && turn >= maxTurns) {
+        force_adjudicate(Adjudication::TurnLimit);
+        return;
+    }
     ++turn;
     pendingRoll = true;
-    activePlayerIndex = playerIndex;
+    set_active_player(playerIndex);
     resolve_game_state();
 }
 
@@ -810,18 +1293,27 @@ void GameState::force_finish_turn() {
 }
 
 void GameState::force_funds(int playerIndex, int funds) {
+    journal_player(playerIndex);
+    zobrist ^= player_key(playerIndex);
     players[playerIndex].funds = funds;
-    std::cout << player_name(playerIndex) << " has $" << funds << std::endl;
+    zobrist ^= player_key(playerIndex);
+    emit(SetFunds{ playerIndex, funds });
 }
 
 void GameState::force_add_funds(int playerIndex, int funds) {
+    journal_player(playerIndex);
+    zobrist ^= player_key(playerIndex);
     players[playerIndex].funds += funds;
-    std::cout << player_name(playerIndex) << " collects $" << funds << std::endl;
+    zobrist ^= player_key(playerIndex);
+    emit(Collected{ playerIndex, funds });
 }
 
 void GameState::force_subtract_funds(int playerIndex, int funds) {
+    journal_player(playerIndex);
+    zobrist ^= player_key(playerIndex);
     players[playerIndex].funds -= funds;
-    std::cout << player_name(playerIndex) << " pays $" << funds << std::endl;
+    zobrist ^= player_key(playerIndex);
+    emit(Paid{ playerIndex, funds });
 
     if (players[playerIndex].funds < 0)
         force_liquidate_to_pay_bank_prompt(playerIndex, -players[playerIndex].funds);
@@ -831,10 +1323,17 @@ void GameState::force_transfer_funds(int fromPlayerIndex, int toPlayerIndex, int
     if (fromPlayerIndex == toPlayerIndex)
         return;
 
+    emit(PaidPlayer{ fromPlayerIndex, toPlayerIndex, funds });
+    transfer_funds(fromPlayerIndex, toPlayerIndex, funds);
+}
+
+void GameState::transfer_funds(int fromPlayerIndex, int toPlayerIndex, int funds) {
+    journal_player(fromPlayerIndex);
+    journal_player(toPlayerIndex);
+    zobrist ^= player_key(fromPlayerIndex) ^ player_key(toPlayerIndex);
     players[fromPlayerIndex].funds -= funds;
     players[toPlayerIndex].funds += funds;
-
-    std::cout << player_name(fromPlayerIndex) << " pays $" << funds << " to " << player_name(toPlayerIndex) << std::endl;
+    zobrist ^= player_key(fromPlayerIndex) ^ player_key(toPlayerIndex);
 
     if (players[fromPlayerIndex].funds < 0)
         force_liquidate_to_pay_player_prompt(fromPlayerIndex, toPlayerIndex, -players[fromPlayerIndex].funds);
@@ -842,9 +1341,12 @@ void GameState::force_transfer_funds(int fromPlayerIndex, int toPlayerIndex, int
 
 void GameState::force_go_to_jail(int playerIndex) {
     force_position(playerIndex, Space::Jail);
+    journal_player(playerIndex);
     if (players[playerIndex].turnsRemainingInJail != MaxJailTurns)
-        std::cout << player_name(playerIndex) << " went to jail!" << std::endl;
+        emit(WentToJail{ playerIndex });
+    zobrist ^= player_key(playerIndex);
     players[playerIndex].turnsRemainingInJail = MaxJailTurns;
+    zobrist ^= player_key(playerIndex);
     force_finish_turn();
 }
 
@@ -854,16 +1356,19 @@ void GameState::force_pay_bail(int playerIndex) {
 }
 
 void GameState::force_leave_jail(int playerIndex) {
+    journal_player(playerIndex);
+    zobrist ^= player_key(playerIndex);
     players[playerIndex].turnsRemainingInJail = 0;
+    zobrist ^= player_key(playerIndex);
 }
 
 void GameState::force_roll(int playerIndex, std::pair<int, int> roll) {
     assert_valid_die_value(roll.first);
     assert_valid_die_value(roll.second);
-    activePlayerIndex = playerIndex;
+    set_active_player(playerIndex);
     lastDiceRoll = roll;
 
-    std::cout << player_name(playerIndex) << " rolled [" << roll.first << "] [" << roll.second << "]" << std::endl;
+    emit(Rolled{ playerIndex, roll });
 
     if (roll.first == roll.second) {
         doublesStreak += 1;
@@ -875,32 +1380,35 @@ void GameState::force_roll(int playerIndex, std::pair<int, int> roll) {
     if (players[playerIndex].turnsRemainingInJail > 0) {
         if (doublesStreak > 0) {
             doublesStreak = 0;
-            std::cout << player_name(playerIndex) << " rolled doubles and left jail" << std::endl;
+            emit(LeftJail{ playerIndex });
             force_leave_jail(playerIndex);
         }
         else {
+            journal_player(playerIndex);
             auto& t = players[playerIndex].turnsRemainingInJail;
+            zobrist ^= player_key(playerIndex);
             t -= 1;
+            zobrist ^= player_key(playerIndex);
             if (t > 0) {
-                std::cout << player_name(playerIndex) << " is stuck in jail" << std::endl;
+                emit(StuckInJail{ playerIndex });
                 force_finish_turn();
                 return;
             }
             else {
-                std::cout << player_name(playerIndex) << " must pay fine" << std::endl;
+                emit(MustPayBail{ playerIndex });
                 force_pay_bail(playerIndex);
             }
         }
     }
     else if (doublesStreak == 3) {
-        std::cout << player_name(playerIndex) << " went to jail for rolling 3 doubles in a row" << std::endl;
+        emit(RolledThreeDoubles{ playerIndex });
         force_go_to_jail(playerIndex);
         return;
     }
 
     pendingRoll = doublesStreak > 0;
     if (pendingRoll)
-        std::cout << player_name(playerIndex) << " gets an extra roll for rolling doubles" << std::endl;
+        emit(ExtraRoll{ playerIndex });
 
     int const sum = roll.first + roll.second;
     force_advance(playerIndex, sum);
@@ -908,10 +1416,10 @@ void GameState::force_roll(int playerIndex, std::pair<int, int> roll) {
 
 void GameState::force_advance(int playerIndex, int dist) {
     auto const currentPos = players[playerIndex].position;
-    std::cout << player_name(playerIndex) << " advanced " << dist << " spaces" << std::endl;
+    emit(Advanced{ playerIndex, dist });
 
     if (advancing_will_pass_go(currentPos, dist)) {
-        std::cout << player_name(playerIndex) << " passed " << to_string(Space::Go) << std::endl;
+        emit(PassedGo{ playerIndex });
         force_add_funds(playerIndex, GoSalary);
     }
 
@@ -920,10 +1428,10 @@ void GameState::force_advance(int playerIndex, int dist) {
 
 void GameState::force_advance_without_landing(int playerIndex, int dist) {
     auto const currentPos = players[playerIndex].position;
-    std::cout << player_name(playerIndex) << " advanced " << dist << " spaces" << std::endl;
+    emit(Advanced{ playerIndex, dist });
 
     if (advancing_will_pass_go(currentPos, dist)) {
-        std::cout << player_name(playerIndex) << " passed " << to_string(Space::Go) << std::endl;
+        emit(PassedGo{ playerIndex });
         force_add_funds(playerIndex, GoSalary);
     }
 
@@ -941,8 +1449,8 @@ void GameState::force_advance_to_without_landing(int playerIndex, Space space) {
 }
 
 void GameState::force_land(int playerIndex, Space space) {
-    activePlayerIndex = playerIndex;
-    std::cout << player_name(playerIndex) << " landed on " << to_string(space) << std::endl;
+    set_active_player(playerIndex);
+    emit(Landed{ playerIndex, space });
     force_leave_jail(playerIndex);
     force_position(playerIndex, space);
     if (space_is_property(space))
@@ -954,7 +1462,8 @@ void GameState::force_land(int playerIndex, Space space) {
         }
         else if (ownerIndex != playerIndex) {
             auto const rent = calculate_rent(property);
-            force_transfer_funds(playerIndex, ownerIndex, rent);
+            emit(PaidRent{ playerIndex, ownerIndex, property, rent });
+            transfer_funds(playerIndex, ownerIndex, rent);
         }
     }
     else {
@@ -989,7 +1498,10 @@ void GameState::force_land(int playerIndex, Space space) {
 }
 
 void GameState::force_position(int playerIndex, Space space) {
+    journal_player(playerIndex);
+    zobrist ^= player_key(playerIndex);
     players[playerIndex].position = space;
+    zobrist ^= player_key(playerIndex);
 }
 
 void GameState::force_property_offer(int playerIndex, Property property) {
@@ -999,7 +1511,20 @@ void GameState::force_property_offer(int playerIndex, Property property) {
 }
 
 void GameState::force_stack_deck(DeckType deckType, DeckContainer const& cards) {
-    decks[deckType].stack_deck(cards);
+    journal(JournalDecks);
+    zobrist ^= deck_key(deckType);
+    deck(deckType).stack_deck(cards);
+    zobrist ^= deck_key(deckType);
+}
+
+void GameState::force_shuffle_unseen_cards() {
+    journal(JournalDecks);
+    journal(JournalRng);
+    for (auto deckType : { DeckType::Chance, DeckType::CommunityChest }) {
+        zobrist ^= deck_key(deckType);
+        deck(deckType).shuffle_unseen(rng);
+        zobrist ^= deck_key(deckType);
+    }
 }
 
 void GameState::force_draw_chance_card(int playerIndex) {
@@ -1011,10 +1536,11 @@ void GameState::force_draw_community_chest_card(int playerIndex) {
 }
 
 void GameState::force_draw_card(int playerIndex, DeckType deckType) {
-    auto& deck = decks[deckType];
-    std::cout << player_name(playerIndex) << " draws a " + to_string(deckType) + " card " << std::endl;
-    auto const card = deck.draw();
-    std::cout << "\t" << card_data(card).effectText << std::endl;
+    journal(JournalDecks);
+    zobrist ^= deck_key(deckType);
+    auto const card = deck(deckType).draw();
+    zobrist ^= deck_key(deckType);
+    emit(DrewCard{ playerIndex, deckType, card });
     apply_card_effect(*this, playerIndex, card);
 }
 
@@ -1022,57 +1548,75 @@ void GameState::force_income_tax(int playerIndex) {
     auto const netWorth = get_net_worth(playerIndex);
     assert(netWorth >= 0);
     auto const tax = std::min<int>(200, static_cast<int> (ceil(netWorth * 0.1)));
-    std::cout << player_name(playerIndex) << " pays income tax (" << tax << ")" << std::endl;
+    emit(PaidTax{ playerIndex, Space::IncomeTax, tax });
     force_subtract_funds(playerIndex, tax);
 }
 
 void GameState::force_luxury_tax(int playerIndex) {
     auto const tax = 100;
-    std::cout << player_name(playerIndex) << " pays luxury tax (" << tax << ")" << std::endl;
+    emit(PaidTax{ playerIndex, Space::LuxuryTax, tax });
     force_subtract_funds(playerIndex, tax);
 }
 
 void GameState::force_give_deed(int playerIndex, Property deed) {
+    journal(JournalBoard);
+    journal_player(playerIndex);
     auto const countErased = bank.deeds.erase(deed);
     assert(countErased == 1);
-    auto const insertRet = players[playerIndex].deeds.insert(deed);
-    assert(insertRet.second);
+    auto const inserted = players[playerIndex].deeds.insert(deed);
+    assert(inserted);
+    zobrist ^= property_key(deed);
+    propertyOwners[static_cast<int> (deed)] = playerIndex;
+    zobrist ^= property_key(deed);
+    update_rent_cache(property_group(deed));
 }
 
-void GameState::force_give_deeds(int playerIndex, std::set<Property> deeds) {
+void GameState::force_give_deeds(int playerIndex, PropertySet deeds) {
     for (auto deed : deeds)
         force_give_deed(playerIndex, deed);
 }
 
 void GameState::force_transfer_deed(int fromPlayerIndex, int toPlayerIndex, Property deed) {
     assert(get_building_level(deed) == 0);
+    journal(JournalBoard);
+    journal_player(fromPlayerIndex);
+    journal_player(toPlayerIndex);
     auto const countErased = players[fromPlayerIndex].deeds.erase(deed);
     assert(countErased == 1);
-    auto const insertRet = players[toPlayerIndex].deeds.insert(deed);
-    assert(insertRet.second);
+    auto const inserted = players[toPlayerIndex].deeds.insert(deed);
+    assert(inserted);
+    zobrist ^= property_key(deed);
+    propertyOwners[static_cast<int> (deed)] = toPlayerIndex;
+    zobrist ^= property_key(deed);
+    update_rent_cache(property_group(deed));
     if (get_property_is_mortgaged(deed)) {
         force_subtract_funds(toPlayerIndex, calculate_closing_costs_on_sale (deed));
     }
 }
 
-void GameState::force_transfer_deeds(int fromPlayerIndex, int toPlayerIndex, std::set<Property> deeds) {
+void GameState::force_transfer_deeds(int fromPlayerIndex, int toPlayerIndex, PropertySet deeds) {
     for (auto deed : deeds)
         force_transfer_deed(fromPlayerIndex, toPlayerIndex, deed);
 }
 
 void GameState::force_set_mortgaged(Property property, bool mortgaged) {
+    journal(JournalBoard);
+    zobrist ^= property_key(property);
     if (mortgaged) {
         mortgagedProperties.insert(property);
     }
     else {
         mortgagedProperties.erase(property);
     }
+    zobrist ^= property_key(property);
+    update_rent_cache(property_group(property));
 }
 
 void GameState::force_sell_all_buildings(int playerIndex, PropertyGroup group) {
+    journal(JournalBoard);
     auto const properties = properties_in_group(group);
     for (auto property : properties) {
-        auto &buildingLevel = buildingLevels[property];
+        auto& buildingLevel = buildingLevels[static_cast<int> (property)];
         auto const ownerIndex = get_property_owner_index(property);
         assert(ownerIndex != Player::None);
         if (ownerIndex == Player::None)
@@ -1084,14 +1628,21 @@ void GameState::force_sell_all_buildings(int playerIndex, PropertyGroup group) {
         if (buildingLevel < HotelLevel) {
             bank.houses += buildingLevel;
         }
+        zobrist ^= property_key(property);
         buildingLevel = 0;
+        zobrist ^= property_key(property);
     }
+    update_rent_cache(group);
     resolve_game_state();
 }
 
 void GameState::force_add_building(Property property) {
-    auto& buildingLevel = buildingLevels[property];
+    journal(JournalBoard);
+    auto& buildingLevel = buildingLevels[static_cast<int> (property)];
+    assert(buildingLevel < HotelLevel);
+    zobrist ^= property_key(property);
     ++buildingLevel;
+    zobrist ^= property_key(property);
     if (buildingLevel < HotelLevel) {
         assert(bank.houses > 0);
         bank.houses -= 1;
@@ -1101,11 +1652,13 @@ void GameState::force_add_building(Property property) {
         bank.hotels -= 1;
         bank.houses += HotelLevel - 1;
     }
-    assert(buildingLevel <= HotelLevel);
+    update_rent_cache(property_group(property));
 }
 
 void GameState::force_remove_building(Property property) {
-    auto& buildingLevel = buildingLevels[property];
+    journal(JournalBoard);
+    auto& buildingLevel = buildingLevels[static_cast<int> (property)];
+    assert(buildingLevel > 0);
     if (buildingLevel < HotelLevel) {
         bank.houses += 1;
     }
@@ -1114,8 +1667,10 @@ void GameState::force_remove_building(Property property) {
         bank.hotels += 1;
         bank.houses -= HotelLevel - 1;
     }
+    zobrist ^= property_key(property);
     --buildingLevel;
-    assert(buildingLevel >= 0);
+    zobrist ^= property_key(property);
+    update_rent_cache(property_group(property));
 }
 
 void GameState::force_set_building_levels(std::map<Property, int> newBuildingLevels) {
@@ -1133,16 +1688,23 @@ void GameState::force_set_building_levels(std::map<Property, int> newBuildingLev
 }
 
 void GameState::force_give_get_out_of_jail_free_card(int playerIndex, DeckType deckType) {
-    auto& deck = decks[deckType];
-    deck.remove_card(get_out_of_jail_free_card(deckType));
+    journal(JournalDecks);
+    journal_player(playerIndex);
+    zobrist ^= deck_key(deckType) ^ player_key(playerIndex);
+    deck(deckType).remove_card(get_out_of_jail_free_card(deckType));
     players[playerIndex].getOutOfJailFreeCards.insert(deckType);
+    zobrist ^= deck_key(deckType) ^ player_key(playerIndex);
 }
 
 void GameState::force_transfer_get_out_of_jail_free_card(int fromPlayerIndex, int toPlayerIndex, DeckType deckType) {
+    journal_player(fromPlayerIndex);
+    journal_player(toPlayerIndex);
     auto& fromCards = players[fromPlayerIndex].getOutOfJailFreeCards;
     auto& toCards = players[toPlayerIndex].getOutOfJailFreeCards;
+    zobrist ^= player_key(fromPlayerIndex) ^ player_key(toPlayerIndex);
     if (fromCards.erase(deckType))
         toCards.insert(deckType);
+    zobrist ^= player_key(fromPlayerIndex) ^ player_key(toPlayerIndex);
 }
 
 void GameState::force_transfer_get_out_of_jail_free_cards(int fromPlayerIndex, int toPlayerIndex, std::set<DeckType> deckTypes) {
@@ -1152,9 +1714,14 @@ void GameState::force_transfer_get_out_of_jail_free_cards(int fromPlayerIndex, i
 }
 
 void GameState::force_return_get_out_of_jail_free_card(int playerIndex, DeckType deckType) {
+    journal(JournalDecks);
+    journal_player(playerIndex);
     auto& player = players[playerIndex];
-    player.getOutOfJailFreeCards.erase(deckType);
-    decks[deckType].add_card(get_out_of_jail_free_card(deckType));
+    zobrist ^= deck_key(deckType) ^ player_key(playerIndex);
+    if (player.getOutOfJailFreeCards.erase(deckType)) {
+        deck(deckType).add_card(get_out_of_jail_free_card(deckType));
+    }
+    zobrist ^= deck_key(deckType) ^ player_key(playerIndex);
 }
 
 void GameState::force_return_get_out_of_jail_free_cards(int playerIndex) {
@@ -1164,6 +1731,9 @@ void GameState::force_return_get_out_of_jail_free_cards(int playerIndex) {
 }
 
 void GameState::force_bankrupt_by_bank(int debtorPlayerIndex) {
+    journal(JournalBoard);
+    journal(JournalAuctionQueue);
+    journal_player(debtorPlayerIndex);
     auto& debtor = players[debtorPlayerIndex];
     for (auto deed : debtor.deeds) {
         if (get_building_level(deed) > 0) {
@@ -1173,8 +1743,18 @@ void GameState::force_bankrupt_by_bank(int debtorPlayerIndex) {
     for (auto property : debtor.deeds) {
         propertiesPendingAuction.push(property);
     }
+    zobrist ^= player_key(debtorPlayerIndex);
     debtor.funds = 0;
-    bank.deeds.insert(debtor.deeds.begin(), debtor.deeds.end());
+    zobrist ^= player_key(debtorPlayerIndex);
+    for (auto property : debtor.deeds) {
+        zobrist ^= property_key(property);
+        propertyOwners[static_cast<int> (property)] = Player::None;
+        zobrist ^= property_key(property);
+    }
+    bank.deeds.insert(debtor.deeds);
+    for (auto property : debtor.deeds) {
+        update_rent_cache(property_group(property));
+    }
     debtor.deeds.clear();
     force_return_get_out_of_jail_free_cards(debtorPlayerIndex);
 }
@@ -1191,15 +1771,39 @@ void GameState::force_bankrupt_by_player(int debtorPlayerIndex, int creditorPlay
     force_transfer_get_out_of_jail_free_cards(debtorPlayerIndex, creditorPlayerIndex);
 }
 
+void GameState::force_adjudicate(Adjudication reason) {
+    if (phase == TurnPhase::GameOver) {
+        return;
+    }
+    auto winner = Player::None;
+    for (auto p = 0; p < get_player_count(); ++p) {
+        if (!players[p].eliminated && (winner == Player::None || get_net_worth(p) > get_net_worth(winner))) {
+            winner = p;
+        }
+    }
+    adjudication = reason;
+    for (auto p = 0; p < get_player_count(); ++p) {
+        if (p != winner && !players[p].eliminated) {
+            journal_player(p);
+            zobrist ^= player_key(p);
+            players[p].eliminated = true;
+            zobrist ^= player_key(p);
+        }
+    }
+    emit(Adjudicated{ reason, winner });
+    resolve_game_state();
+}
+
 void GameState::force_property_offer_prompt(int playerIndex, Property property) {
-    std::cout << player_name(playerIndex) << ": Buy " << to_string(property) << " or let it go to auction?" << std::endl;
-    activePlayerIndex = playerIndex;
+    emit(OfferedProperty{ playerIndex, property });
+    set_active_player(playerIndex);
     pendingPurchaseDecision = true;
     resolve_game_state();
 }
 
 void GameState::force_liquidate_to_pay_bank_prompt(int debtorPlayerIndex, int amount) {
-    std::cout << player_name(debtorPlayerIndex) << ": You are in debt. Manage property or trade to come up with the funds OR declare bankruptcy!" << std::endl;
+    journal(JournalDebts);
+    emit(IncurredDebt{ debtorPlayerIndex, Player::None, amount });
     Debt debt;
     debt.debtor = debtorPlayerIndex;
     debt.amount = amount;
@@ -1207,8 +1811,8 @@ void GameState::force_liquidate_to_pay_bank_prompt(int debtorPlayerIndex, int am
 }
 
 void GameState::force_liquidate_to_pay_player_prompt(int debtorPlayerIndex, int creditorPlayerIndex, int amount) {
-    std::cout << player_name(debtorPlayerIndex) << ": You are in debt to " << player_name(creditorPlayerIndex)
-        << ". Manage property or trade to come up with the funds OR declare bankruptcy!" << std::endl;
+    journal(JournalDebts);
+    emit(IncurredDebt{ debtorPlayerIndex, creditorPlayerIndex, amount });
     Debt debt;
     debt.debtor = debtorPlayerIndex;
     debt.amount = amount;
@@ -1241,19 +1845,23 @@ Deck GameState::init_deck(GameSetup const& setup, DeckType deck_type) {
     return Deck(deck_type);
 }
 
-std::map<DeckType, Deck> GameState::init_decks(GameSetup const& setup) {
+std::array<Deck, 2> GameState::init_decks(GameSetup const& setup) {
     return {
-        { DeckType::Chance, init_deck(setup, DeckType::Chance) },
-        { DeckType::CommunityChest, init_deck(setup, DeckType::CommunityChest) },
+        init_deck(setup, DeckType::Chance),
+        init_deck(setup, DeckType::CommunityChest),
     };
 }
 
+Deck& GameState::deck(DeckType deckType) {
+    return decks[static_cast<int> (deckType)];
+}
+
 void GameState::resolve_game_state() {
     if (get_players_remaining_count () < 2) {
-        phase = TurnPhase::GameOver;
+        set_phase(TurnPhase::GameOver);
     }
     else if (pendingTradeAgreement.has_value ()) {
-        phase = TurnPhase::WaitingForTradeOfferResponse;
+        set_phase(TurnPhase::WaitingForTradeOfferResponse);
     }
     else if (!pendingDebtSettlements.empty()) {
         resolve_debt_settlements();
@@ -1268,16 +1876,16 @@ void GameState::resolve_game_state() {
         resolve_queued_auction(propertiesPendingAuction.front());
     }
     else if (!pendingAcquisitions.empty()) {
-        phase = TurnPhase::WaitingForAcquisitionManagement;
+        set_phase(TurnPhase::WaitingForAcquisitionManagement);
     }
     else if (pendingPurchaseDecision) {
-        phase = TurnPhase::WaitingForBuyPropertyInput;
+        set_phase(TurnPhase::WaitingForBuyPropertyInput);
     }
     else if (pendingRoll) {
-        phase = TurnPhase::WaitingForRoll;
+        set_phase(TurnPhase::WaitingForRoll);
     }
     else if (activePlayerIndex != get_next_player_index ()) {
-        phase = TurnPhase::WaitingForTurnEnd;
+        set_phase(TurnPhase::WaitingForTurnEnd);
     }
 }
 
@@ -1286,32 +1894,34 @@ void GameState::resolve_debt_settlements() {
     auto const debt = pendingDebtSettlements.front();
 
     if (players[debt.debtor].funds >= 0) {
+        journal(JournalDebts);
         pendingDebtSettlements.pop_front();
         resolve_game_state();
     }
     else {
-        phase = TurnPhase::WaitingForDebtSettlement;
+        set_phase(TurnPhase::WaitingForDebtSettlement);
     }
 }
 
 void GameState::resolve_auction() {
+    journal(JournalAuction);
+    journal(JournalAuctionSale);
     auto const highestBidderIndex = currentAuction.biddingOrder.back();
     auto const nextBidderIndex = currentAuction.biddingOrder.front();
-    std::cout << to_string (currentAuction.property) << " going to " <<
-        player_name(highestBidderIndex) << " for $" << currentAuction.highestBid << std::endl;
-    phase = TurnPhase::WaitingForBids;
+    emit(AuctionStanding{ currentAuction.property, highestBidderIndex, currentAuction.highestBid });
+    set_phase(TurnPhase::WaitingForBids);
     if (currentAuction.biddingOrder.size() > 1) {
         if (check_if_player_is_allowed_to_bid(nextBidderIndex, currentAuction.highestBid + 1)) {
-            std::cout << player_name(nextBidderIndex) << ": Bid or decline?" << std::endl;
+            emit(BidRequested{ nextBidderIndex });
         }
         else {
-            std::cout << player_name(nextBidderIndex) << " can't afford to bid more than " << currentAuction.highestBid << std::endl;
+            emit(CannotAffordBid{ nextBidderIndex, currentAuction.highestBid });
             player_action_decline_bid(nextBidderIndex);
             resolve_game_state();
         }
     }
     else {
-        std::cout << player_name(highestBidderIndex) << " won the auction of " << to_string(currentAuction.property) << " for $" << currentAuction.highestBid << std::endl;
+        emit(WonAuction{ highestBidderIndex, currentAuction.property, currentAuction.highestBid });
         auto const payment = currentAuction.highestBid + calculate_closing_costs_on_sale(currentAuction.property);
         pendingAuctionSale = { highestBidderIndex, currentAuction.property };
         currentAuction = {};
@@ -1322,16 +1932,18 @@ void GameState::resolve_auction() {
 
 void GameState::resolve_auction_sale() {
     assert(pendingAuctionSale.has_value());
+    journal(JournalAuctionSale);
+    journal(JournalAuctionQueue);
     auto const highestBidderIndex = pendingAuctionSale->first;
     auto const property = pendingAuctionSale->second;
 
     assert(pendingDebtSettlements.empty());
     if (! players[highestBidderIndex].eliminated) {
-        std::cout << player_name(highestBidderIndex) << " received " << to_string(property) << std::endl;
+        emit(ReceivedProperty{ highestBidderIndex, property });
         force_give_deed(highestBidderIndex, property);
     }
     else {
-        std::cout << player_name(highestBidderIndex) << " won the bid, but declared bankruptcy, " << to_string(property) << " goes back up for auction" << std::endl;
+        emit(AuctionWinnerBankrupt{ highestBidderIndex, property });
         propertiesPendingAuction.push(property);
     }
     pendingAuctionSale = {};
@@ -1339,7 +1951,9 @@ void GameState::resolve_auction_sale() {
 }
 
 void GameState::resolve_queued_auction(Property property) {
-    std::cout << "Auctioning property " << to_string (property) << std::endl;
+    emit(AuctionStarted{ property });
+    journal(JournalAuction);
+    journal(JournalAuctionQueue);
     currentAuction = Auction{};
     // Determine order of auction
     for (int i = get_next_player_index(activePlayerIndex); i != activePlayerIndex; i = get_next_player_index(i)) {
@@ -2,9 +2,13 @@
 
 #include"Cards.h"
 #include"Board.h"
+#include"GameEvents.h"
 #include"Player.h"
+#include"Random.h"
 
 #include<algorithm>
+#include<array>
+#include<chrono>
 #include<list>
 #include<map>
 #include<optional>
@@ -25,6 +29,8 @@ namespace monopoly
         GameOver,
     };
 
+    class ActionBuffer;
+
     struct GameSetup
     {
         std::string seed;
@@ -36,13 +42,56 @@ namespace monopoly
         // Put these cards on top after shuffling
         std::vector<Card> stackCommunityChest = {};
         std::vector<Card> stackChance = {};
+
+        // Generator for the dice and shuffles, Pcg32 is much cheaper to copy than the original Mt19937
+        RngKind rng = RngKind::Mt19937;
+
+        // A game still going after this many turns, or after running this long in a Game, is won by the player
+        // with the highest net worth, earliest seat first on a tie. get_adjudication tells which limit ended it.
+        // Zero is no limit.
+        int maxTurns = 0;
+        std::chrono::milliseconds maxWallTime{ 0 };
+
+        // Receives the events of the game, no events are reported if null
+        IGameEventSink* eventSink = nullptr;
+    };
+
+    // Building level of each property, indexed by property (HotelLevel is a hotel)
+    using BuildingLevels = std::array<uint8_t, PropertyCount>;
+
+    // Layout of the feature vectors written by GameState::encode_features
+    //
+    // Each entry is the offset of a block of features. Every feature is 0 or 1
+    // except funds, and players past the player count are left at 0. Vectors
+    // are padded to a multiple of 16 floats so consecutive vectors in a batch
+    // start on a 64 byte boundary.
+    struct FeatureLayout
+    {
+        static constexpr int PhaseCount = 8;
+        static constexpr int MaxDoublesStreak = 2;
+
+        static constexpr int Position = 0;                                          // [player][space]
+        static constexpr int Funds = Position + MaxPlayerCount * NumberOfSpaces;    // [player], scaled by FundsScale
+        static constexpr int PlayerFlags = Funds + MaxPlayerCount;                  // [player][in game, active, controlling]
+        static constexpr int Jail = PlayerFlags + MaxPlayerCount * 3;               // [player][turns left in jail - 1]
+        static constexpr int Cards = Jail + MaxPlayerCount * MaxJailTurns;          // [player][deck] holds its Get Out of Jail Free card
+        static constexpr int Owner = Cards + MaxPlayerCount * 2;                    // [property][player, the bank last]
+        static constexpr int Mortgaged = Owner + PropertyCount * (MaxPlayerCount + 1); // [property]
+        static constexpr int Buildings = Mortgaged + PropertyCount;                 // [property][building level]
+        static constexpr int Phase = Buildings + PropertyCount * (HotelLevel + 1);  // [turn phase]
+        static constexpr int DeckTop = Phase + PhaseCount;                          // [deck][top card, from the first card of the deck]
+        static constexpr int DoublesStreak = DeckTop + 2 * Deck::Capacity;          // [doubles streak]
+        static constexpr int Size = DoublesStreak + MaxDoublesStreak + 1;
+        static constexpr int Stride = (Size + 15) / 16 * 16;
+
+        static constexpr float FundsScale = 1.0f / 2000.0f;
     };
 
     struct Bank
     {
         int houses = 32;
         int hotels = 12;
-        std::set<Property> deeds = all_properties();
+        PropertySet deeds = all_properties();
 
         inline bool operator==(Bank const& rhs) const {
             return
@@ -91,6 +140,7 @@ namespace monopoly
 
         bool operator== (Auction const& rhs) const {
             return
+                property == rhs.property &&
                 highestBid == rhs.highestBid &&
                 biddingOrder == rhs.biddingOrder;
         }
@@ -113,7 +163,7 @@ namespace monopoly
 
     struct Promise {
         int cash = 0;
-        std::set<Property> deeds;
+        PropertySet deeds;
         std::set<DeckType> getOutOfJailFreeCards;
 
         bool operator== (Promise const& rhs) const {
@@ -135,17 +185,14 @@ namespace monopoly
             return deeds.size();
         }
         Property deed_at(int i) const {
-            auto it = std::begin(deeds);
-            std::advance(it, i);
-            return *it;
+            return deeds.at(i);
         }
         bool contains_deed(Property deed) {
             return deeds.count(deed);
         }
         void toggle_deed(Property deed) {
-            auto const ret = deeds.insert(deed);
-            if (! ret.second)
-                deeds.erase(ret.first);
+            if (! deeds.insert(deed))
+                deeds.erase(deed);
         }
         bool contains_card(DeckType card) {
             return getOutOfJailFreeCards.count(card);
@@ -188,7 +235,7 @@ namespace monopoly
 
     struct Acquisition {
         int recipient;
-        std::set<Property> deeds;
+        PropertySet deeds;
 
         bool operator== (Acquisition const& rhs) const {
             return
@@ -202,7 +249,13 @@ namespace monopoly
     {
     public:
         explicit GameState(GameSetup setup = {});
+        void set_event_sink(IGameEventSink* sink);
+        IGameEventSink* get_event_sink() const;
         bool is_game_over() const;
+        // Why the game was decided on net worth, Adjudication::None unless it was
+        Adjudication get_adjudication() const;
+        // The last player standing, Player::None until the game is over
+        int get_winner_index() const;
         int get_turn() const;
         Bank get_bank() const;
         int get_player_count() const;
@@ -211,8 +264,9 @@ namespace monopoly
         int get_player_funds(int playerIndex) const;
         Space get_player_position(int playerIndex) const;
         int get_player_turns_remaining_in_jail(int playerIndex) const;
-        std::set<Property> get_player_deeds(int playerIndex) const;
+        PropertySet get_player_deeds(int playerIndex) const;
         std::set<DeckType> get_player_get_out_of_jail_free_cards(int playerIndex) const;
+        Deck const& get_deck(DeckType deckType) const;
         int get_active_player_index() const; // it's the active player's turn
         int get_controlling_player_index() const; // the game is waiting on input from the controlling player
         int get_next_player_index(int playerIndex = -1) const; // if -1, use activePlayerIndex
@@ -225,16 +279,33 @@ namespace monopoly
         int get_building_level(Property property) const;
         int get_min_building_level_in_group(PropertyGroup group) const;
         int get_max_building_level_in_group(PropertyGroup group) const;
-        std::map<Property, int> const& get_building_levels() const;
+        BuildingLevels const& get_building_levels() const;
         Trade get_pending_trade_offer() const;
         Auction get_current_auction() const;
         int calculate_rent(Property property) const;
         int calculate_closing_costs_on_sale(Property property) const;
         int calculate_liquid_assets_value(int playerIndex) const;
-        int calculate_liquid_value_of_deeds(std::set<Property> deeds) const;
-        int calculate_liquid_value_of_buildings(std::set<Property> deeds) const;
+        int calculate_liquid_value_of_deeds(PropertySet deeds) const;
+        int calculate_liquid_value_of_buildings(PropertySet deeds) const;
         int calculate_liquid_value_of_promise(Promise promise) const;
 
+        // Zobrist hash of player positions, funds, jail turns and cards, owners, mortgages, buildings, deck order,
+        // the active player and the phase. Kept up to date by every change to the state, so reading it is free.
+        // Auctions, debts, trades and the dice are not covered, equal hashes can still differ in those.
+        // Building with MONOPOLY_VERIFY_HASH checks it against recompute_hash() on every read.
+        uint64_t hash() const;
+        uint64_t recompute_hash() const;
+        // Like hash, but the same whatever the order of the cards nobody has seen yet, so it only covers
+        // what the players know
+        uint64_t observed_hash() const;
+        // Hash of everything that decides how the game plays out from here, except the random number generator
+        uint64_t compact_hash() const;
+
+        // Write the FeatureLayout::Stride floats of this state's feature vector to out, without allocating
+        void encode_features(float* out) const;
+        // Write the feature vectors of count states one after the other, FeatureLayout::Stride floats apart
+        static void encode_features(GameState const* const* states, std::size_t count, float* out);
+
         std::pair<int, int> random_dice_roll();
         std::pair<int, int> get_last_dice_roll() const;
 
@@ -258,7 +329,24 @@ namespace monopoly
         bool check_if_player_can_fulfill_promise(int playerIndex, Promise promise) const;
         bool check_if_player_can_pay_closing_costs(int playerIndex, Promise lostAssets, Promise gainedAssets) const;
 
+        // Replace the contents of actions with every input that playerIndex is allowed to make right now.
+        // Bids are bucketed by actions.bidIncrements, and the only trade enumerated is accepting a pending
+        // offer (new offers are left to dedicated trade search). Resigning is always last.
+        void legal_actions(int playerIndex, ActionBuffer& actions) const;
+
+        // Undo journal
+        //
+        // While journaling, every player_action_* records the parts of the state it changes, and undo() restores
+        // the state from before the most recent recorded action. Search can then explore a line of play by applying
+        // and undoing actions in place instead of copying the whole state for every node. Changes made directly
+        // through force_* are not recorded.
+        void set_journaling(bool enabled); // disabling discards the recorded actions
+        bool is_journaling() const;
+        int get_undo_depth() const; // number of recorded actions that can be undone
+        void undo();
+
         void player_action_roll(int playerIndex);
+        void player_action_roll(int playerIndex, std::pair<int, int> roll); // roll loaded dice
         void player_action_use_get_out_of_jail_free_card(int playerIndex, DeckType preferredDeckType);
         void player_action_pay_bail(int playerIndex);
         void player_action_buy_property(int playerIndex);
@@ -275,6 +363,7 @@ namespace monopoly
         void player_action_end_turn(int playerIndex);
         void player_action_resign(int playerIndex);
 
+        void force_reseed(unsigned seed); // search reseeds copies of the state to sample different dice
         void force_start_turn(int playerIndex);
         void force_finish_turn();
 
@@ -298,6 +387,9 @@ namespace monopoly
         void force_property_offer(int playerIndex, Property space);
 
         void force_stack_deck(DeckType deckType, DeckContainer const& cards);
+        // Reorder the cards nobody has seen in both decks with the state's random number generator. Search
+        // does this to each copy it plays out so that it can't know the upcoming cards.
+        void force_shuffle_unseen_cards();
         void force_draw_chance_card(int playerIndex);
         void force_draw_community_chest_card(int playerIndex);
         void force_draw_card(int playerIndex, DeckType deckType);
@@ -306,9 +398,9 @@ namespace monopoly
         void force_luxury_tax(int playerIndex);
 
         void force_give_deed(int playerIndex, Property property);
-        void force_give_deeds(int playerIndex, std::set<Property> properties);
+        void force_give_deeds(int playerIndex, PropertySet properties);
         void force_transfer_deed(int fromPlayerIndex, int toPlayerIndex, Property deed);
-        void force_transfer_deeds(int fromPlayerIndex, int toPlayerIndex, std::set<Property> deeds);
+        void force_transfer_deeds(int fromPlayerIndex, int toPlayerIndex, PropertySet deeds);
 
         void force_set_mortgaged(Property property, bool mortgaged);
 
@@ -325,6 +417,8 @@ namespace monopoly
 
         void force_bankrupt_by_bank(int debtorPlayerIndex);
         void force_bankrupt_by_player(int debtorPlayerIndex, int creditorPlayerIndex);
+        // End the game in favour of the player with the highest net worth, ties going to the earliest seat
+        void force_adjudicate(Adjudication reason);
 
         void force_property_offer_prompt(int playerIndex, Property property);
         void force_liquidate_to_pay_bank_prompt(int debtorPlayerIndex, int amount);
@@ -352,7 +446,8 @@ namespace monopoly
                 pendingAcquisitions == rhs.pendingAcquisitions &&
                 pendingPurchaseDecision == rhs.pendingPurchaseDecision &&
                 pendingRoll == rhs.pendingRoll &&
-                activePlayerIndex == rhs.activePlayerIndex;
+                activePlayerIndex == rhs.activePlayerIndex &&
+                adjudication == rhs.adjudication;
         }
         inline bool operator!=(GameState const& rhs) const {
             return !operator==(rhs);
@@ -362,22 +457,122 @@ namespace monopoly
         static Player init_player(GameSetup const& setup);
         static std::vector<Player> init_players(GameSetup const& setup);
         static Deck init_deck(GameSetup const& setup, DeckType deck_type);
-        static std::map<DeckType, Deck> init_decks(GameSetup const& setup);
+        static std::array<Deck, 2> init_decks(GameSetup const& setup);
+        Deck& deck(DeckType deckType);
+
+        template<typename EVENT>
+        void emit(EVENT const& event) const {
+            if (eventSink) {
+                eventSink->on_event(event);
+            }
+        }
+        void transfer_funds(int fromPlayerIndex, int toPlayerIndex, int funds);
+        int compute_rent(Property property) const;
+        void update_rent_cache(PropertyGroup group);
+
+        // Parts of the state saved by the undo journal, each is saved at most once per action
+        enum JournalPart : uint16_t {
+            JournalFlow = 1 << 0, // turn, phase, dice and the pending roll, purchase and active player
+            JournalBoard = 1 << 1, // bank, owners, mortgages, buildings and rent
+            JournalDecks = 1 << 2,
+            JournalRng = 1 << 3,
+            JournalTrade = 1 << 4,
+            JournalDebts = 1 << 5,
+            JournalAuction = 1 << 6,
+            JournalAuctionSale = 1 << 7,
+            JournalAuctionQueue = 1 << 8,
+        };
+        struct FlowRecord {
+            int turn;
+            TurnPhase phase;
+            int doublesStreak;
+            std::pair<int, int> lastDiceRoll;
+            bool pendingPurchaseDecision;
+            bool pendingRoll;
+            int activePlayerIndex;
+            Adjudication adjudication;
+        };
+        struct BoardRecord {
+            Bank bank;
+            std::array<int, PropertyCount> propertyOwners;
+            PropertySet mortgagedProperties;
+            BuildingLevels buildingLevels;
+            std::array<int, PropertyCount> rentCache;
+        };
+        struct UndoRecord {
+            uint16_t parts = 0;
+            uint16_t players = 0; // one bit per saved player
+            uint64_t hash = 0;
+        };
+        // Saved parts are kept on one stack per part, so the stacks grow to the deepest line of play and are then
+        // reused without allocating
+        struct UndoJournal {
+            bool enabled = false;
+            int actionDepth = 0; // player actions call each other, only the outermost one starts a record
+            std::vector<UndoRecord> records;
+            std::vector<FlowRecord> flows;
+            std::vector<BoardRecord> boards;
+            std::vector<std::pair<int, Player>> players;
+            std::vector<std::array<Deck, 2>> decks;
+            // Only the first rngCount are saved, the slots past it keep their mt19937 so that saving the
+            // generator copies into it instead of allocating a new one
+            std::vector<Rng> rngs;
+            std::size_t rngCount = 0;
+            std::vector<std::optional<Trade>> trades;
+            std::vector<std::list<Debt>> debts;
+            std::vector<Auction> auctions;
+            std::vector<std::optional<std::pair<int, Property>>> auctionSales;
+            std::vector<std::queue<Property>> auctionQueues;
+        };
+        class JournalScope {
+        public:
+            explicit JournalScope(UndoJournal& journal)
+                : journal(journal) {
+                ++journal.actionDepth;
+            }
+            JournalScope(JournalScope const&) = delete;
+            JournalScope& operator=(JournalScope const&) = delete;
+            ~JournalScope() {
+                --journal.actionDepth;
+            }
+        private:
+            UndoJournal& journal;
+        };
+        JournalScope journal_action();
+        void journal(JournalPart part);
+        void journal_player(int playerIndex);
+
+        // Zobrist keys of the parts of the state covered by hash(). Each change XORs out the key of what it is about
+        // to change and XORs in the key of the result.
+        uint64_t player_key(int playerIndex) const;
+        uint64_t property_key(Property property) const;
+        uint64_t deck_key(DeckType deckType) const;
+        uint64_t flow_key() const;
+        void set_phase(TurnPhase newPhase);
+        void set_active_player(int playerIndex);
 
+        IGameEventSink* eventSink;
+        UndoJournal undoJournal;
+        uint64_t zobrist;
 
-        std::mt19937 rng;
+        Rng rng;
 
         int turn = 0;
         TurnPhase phase;
         Bank bank;
-        std::map<DeckType, Deck> decks;
+        std::array<Deck, 2> decks; // indexed by DeckType
 
         std::vector<Player> players;
         int doublesStreak;
         std::pair<int, int> lastDiceRoll;
 
-        std::set<Property> mortgagedProperties;
-        std::map<Property, int> buildingLevels;
+        // Owner of each property, indexed by property (Player::None if bank owned), kept in sync with the deeds
+        std::array<int, PropertyCount> propertyOwners;
+        PropertySet mortgagedProperties;
+        BuildingLevels buildingLevels;
+        // Rent of each property, indexed by property. Utilities store the multiplier applied to the dice roll.
+        // Updated whenever ownership, buildings or mortgages change in a group, so landing on a property is a lookup
+        std::array<int, PropertyCount> rentCache;
 
         // Resolution order
         //
@@ -411,6 +606,8 @@ namespace monopoly
         // Handle end turn input
         int activePlayerIndex;
         // Game over (next player is active player)
+        int maxTurns;
+        Adjudication adjudication;
 
         // Through user action, pending events can be resolved and cleared, or
         // higher priority events can be raised, until the end of the game. A
@@ -2,6 +2,7 @@
 
 #include "Game.h"
 #include "Input.h"
+#include "StateChanges.h"
 
 #include <queue>
 
@@ -15,7 +16,14 @@ namespace monopoly
         // Get any queued inputs (player index, Input), buffered inputs should be cleared after polling
         virtual std::queue<PlayerIndexInputPair> poll() = 0;
         // Process changes in game state
-        virtual void update(GameState state) = 0;
+        // The state is owned by the game and stays at the same address for as long as the game exists,
+        // so an interface may keep the reference between calls to read the current state. Copy it (or
+        // take a Game::snapshot) to keep the state as it was at this call.
+        virtual void update(GameState const& state) = 0;
+        // Opt in to receive the changes made during each process cycle, before update is called
+        virtual bool wants_changes() const { return false; }
+        // The fields that changed since the previous cycle, only called if there were any
+        virtual void on_changes(std::vector<StateChange> const& changes) {}
 
     };
 
@@ -6,6 +6,7 @@
 #include <map>
 #include <set>
 #include <variant>
+#include <vector>
 
 namespace monopoly {
 
@@ -43,13 +44,13 @@ namespace monopoly {
     // Unmortgage real estate properties.
     // You may do this at any time on your turn between actions, or when prompted
     struct UnmortgagePropertiesInput {
-        std::set<Property> properties;
+        PropertySet properties;
     };
 
     // Mortgage real estate properties.
     // You may do this at any time on your turn between actions, or when prompted
     struct MortgagePropertiesInput {
-        std::set<Property> properties;
+        PropertySet properties;
     };
 
     // Get out of jail without paying paying bail
@@ -117,6 +118,46 @@ namespace monopoly {
     >;
     using PlayerIndexInputPair = std::pair<int, Input>;
 
+    // Reusable storage for the inputs enumerated by GameState::legal_actions
+    //
+    // Clearing keeps the capacity, so a buffer reused across decisions stops
+    // allocating once it has grown to fit the largest set of legal actions.
+    class ActionBuffer
+    {
+    public:
+        // Bids are enumerated as these increments over the highest bid
+        std::vector<int> bidIncrements = { 1, 10, 50, 100, 250 };
+
+        ActionBuffer() {
+            actions.reserve(64);
+        }
+
+        void clear() {
+            actions.clear();
+        }
+        void push_back(Input input) {
+            actions.push_back(std::move(input));
+        }
+        int size() const {
+            return static_cast<int> (actions.size());
+        }
+        bool empty() const {
+            return actions.empty();
+        }
+        Input const& operator[](int i) const {
+            return actions[i];
+        }
+        std::vector<Input>::const_iterator begin() const {
+            return actions.begin();
+        }
+        std::vector<Input>::const_iterator end() const {
+            return actions.end();
+        }
+
+    private:
+        std::vector<Input> actions;
+    };
+
     inline Trade trade_from_offer_input(int playerIndex, OfferTradeInput offerInput) {
         Trade trade;
         trade.offeringPlayer = playerIndex;
@@ -0,0 +1,234 @@
+#include "LandingProbabilities.h"
+#include "Cards.h"
+using namespace monopoly;
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr int MaxStreak = 3; // a third double goes to jail
+    constexpr int StreakStates = NumberOfSpaces * MaxStreak;
+    constexpr int StateCount = StreakStates + MaxJailTurns;
+    constexpr int SentToJail = -1;
+    constexpr int MaxIterations = 100000;
+    constexpr double Tolerance = 1e-13;
+
+    constexpr int streak_state(int spaceIndex, int streak) {
+        return spaceIndex * MaxStreak + streak;
+    }
+
+    // State of a player in jail with turnsLeft before bail is due
+    constexpr int jail_state(int turnsLeft) {
+        return StreakStates + turnsLeft - 1;
+    }
+
+    constexpr bool ends_turn(int state) {
+        return state >= StreakStates || state % MaxStreak == 0;
+    }
+
+    constexpr int space_of_state(int state) {
+        return state >= StreakStates ? space_to_index(Space::Jail) : state / MaxStreak;
+    }
+
+    DeckContainer const* deck_at(Space space) {
+        switch (space) {
+        case Space::Chance_1:
+        case Space::Chance_2:
+        case Space::Chance_3:
+            return &ChanceCards;
+        case Space::CommunityChest_1:
+        case Space::CommunityChest_2:
+        case Space::CommunityChest_3:
+            return &CommunityChestCards;
+        default:
+            return nullptr;
+        }
+    }
+
+    // Where a token arriving on space ends up, SentToJail or a space index, weighted by probability
+    void resolve(Space space, double probability, std::vector<std::pair<int, double>>& outcomes) {
+        if (space == Space::GoToJail) {
+            outcomes.emplace_back(SentToJail, probability);
+            return;
+        }
+        auto const deck = deck_at(space);
+        if (!deck) {
+            outcomes.emplace_back(space_to_index(space), probability);
+            return;
+        }
+        auto const cardProbability = probability / deck->size();
+        for (auto card : *deck) {
+            auto const& effect = card_effect(card);
+            switch (effect.kind) {
+            case CardEffectKind::AdvanceTo:
+                outcomes.emplace_back(effect.space, cardProbability);
+                break;
+            case CardEffectKind::AdvanceToNearestRailroad:
+                outcomes.emplace_back(space_to_index(nearest_space(space, { Space::Railroad_1, Space::Railroad_2, Space::Railroad_3, Space::Railroad_4 })), cardProbability);
+                break;
+            case CardEffectKind::AdvanceToNearestUtility:
+                outcomes.emplace_back(space_to_index(nearest_space(space, { Space::Utility_1, Space::Utility_2 })), cardProbability);
+                break;
+            case CardEffectKind::Move:
+                resolve(add_distance(space, effect.amount), cardProbability, outcomes);
+                break;
+            case CardEffectKind::GoToJail:
+                outcomes.emplace_back(SentToJail, cardProbability);
+                break;
+            default:
+                outcomes.emplace_back(space_to_index(space), cardProbability);
+                break;
+            }
+        }
+    }
+
+    // Adds where a token moving distance spaces ends up, with nextStreak doubles in a row if it stays out of jail
+    void move(int spaceIndex, int distance, int nextStreak, double probability, std::vector<std::pair<int, double>>& transitions) {
+        std::vector<std::pair<int, double>> outcomes;
+        resolve(add_distance(index_to_space(spaceIndex), distance), probability, outcomes);
+        for (auto const& [destination, p] : outcomes) {
+            transitions.emplace_back(destination == SentToJail ? jail_state(MaxJailTurns) : streak_state(destination, nextStreak), p);
+        }
+    }
+
+    void roll_from(int spaceIndex, int streak, std::vector<std::pair<int, double>>& transitions) {
+        for (auto d1 = 1; d1 <= 6; ++d1) {
+            for (auto d2 = 1; d2 <= 6; ++d2) {
+                auto const doubles = d1 == d2;
+                if (doubles && streak == MaxStreak - 1) {
+                    transitions.emplace_back(jail_state(MaxJailTurns), 1.0 / 36.0);
+                }
+                else {
+                    move(spaceIndex, d1 + d2, doubles ? streak + 1 : 0, 1.0 / 36.0, transitions);
+                }
+            }
+        }
+    }
+}
+
+LandingProbabilities const& LandingProbabilities::get(JailStrategy strategy) {
+    static LandingProbabilities const roll(JailStrategy::Roll);
+    static LandingProbabilities const payBail(JailStrategy::PayBail);
+    return strategy == JailStrategy::Roll ? roll : payBail;
+}
+
+LandingProbabilities::LandingProbabilities(JailStrategy strategy)
+    : strategy(strategy)
+    , transitions(StateCount)
+    , perRoll()
+    , perTurn()
+{
+    auto const jail = space_to_index(Space::Jail);
+    for (auto space = 0; space < NumberOfSpaces; ++space) {
+        for (auto streak = 0; streak < MaxStreak; ++streak) {
+            roll_from(space, streak, transitions[streak_state(space, streak)]);
+        }
+    }
+    for (auto turnsLeft = 1; turnsLeft <= MaxJailTurns; ++turnsLeft) {
+        auto& t = transitions[jail_state(turnsLeft)];
+        if (strategy == JailStrategy::PayBail) {
+            roll_from(jail, 0, t);
+            continue;
+        }
+        // Doubles leave jail without another roll, otherwise wait, or pay bail on the last turn and move anyway
+        for (auto d1 = 1; d1 <= 6; ++d1) {
+            for (auto d2 = 1; d2 <= 6; ++d2) {
+                if (d1 == d2 || turnsLeft == 1) {
+                    move(jail, d1 + d2, 0, 1.0 / 36.0, t);
+                }
+                else {
+                    t.emplace_back(jail_state(turnsLeft - 1), 1.0 / 36.0);
+                }
+            }
+        }
+    }
+
+    // Long run distribution by power iteration from the start of the game
+    Distribution states(StateCount, 0.0);
+    states[streak_state(0, 0)] = 1.0;
+    for (auto i = 0; i < MaxIterations; ++i) {
+        auto next = step(states);
+        auto change = 0.0;
+        for (auto s = 0; s < StateCount; ++s) {
+            change += std::abs(next[s] - states[s]);
+        }
+        // Average two steps so a chain that alternates still settles
+        for (auto s = 0; s < StateCount; ++s) {
+            states[s] = 0.5 * (states[s] + next[s]);
+        }
+        if (change < Tolerance) {
+            break;
+        }
+    }
+    add_landings(states, perRoll);
+
+    auto turnEnds = 0.0;
+    for (auto s = 0; s < StateCount; ++s) {
+        if (ends_turn(s)) {
+            turnEnds += states[s];
+        }
+    }
+    for (auto space = 0; space < NumberOfSpaces; ++space) {
+        perTurn[space] = perRoll[space] / turnEnds;
+    }
+}
+
+SpaceTable const& LandingProbabilities::per_roll() const {
+    return perRoll;
+}
+
+SpaceTable const& LandingProbabilities::per_turn() const {
+    return perTurn;
+}
+
+double LandingProbabilities::per_roll(Space space) const {
+    return perRoll[space_to_index(space)];
+}
+
+double LandingProbabilities::per_turn(Space space) const {
+    return perTurn[space_to_index(space)];
+}
+
+SpaceTable LandingProbabilities::horizon(Space start, int turns) const {
+    SpaceTable landings{};
+    Distribution turnStarts(StateCount, 0.0);
+    turnStarts[streak_state(space_to_index(start), 0)] = 1.0;
+    for (auto turn = 0; turn < turns; ++turn) {
+        Distribution nextTurnStarts(StateCount, 0.0);
+        auto rolling = std::move(turnStarts);
+        for (auto roll = 0; roll < MaxStreak; ++roll) {
+            auto const rolled = step(rolling);
+            add_landings(rolled, landings);
+            std::fill(rolling.begin(), rolling.end(), 0.0);
+            for (auto s = 0; s < StateCount; ++s) {
+                (ends_turn(s) ? nextTurnStarts : rolling)[s] += rolled[s];
+            }
+        }
+        turnStarts = std::move(nextTurnStarts);
+    }
+    return landings;
+}
+
+JailStrategy LandingProbabilities::get_strategy() const {
+    return strategy;
+}
+
+LandingProbabilities::Distribution LandingProbabilities::step(Distribution const& from) const {
+    Distribution to(StateCount, 0.0);
+    for (auto s = 0; s < StateCount; ++s) {
+        if (from[s] == 0.0) {
+            continue;
+        }
+        for (auto const& [destination, probability] : transitions[s]) {
+            to[destination] += from[s] * probability;
+        }
+    }
+    return to;
+}
+
+void LandingProbabilities::add_landings(Distribution const& states, SpaceTable& landings) const {
+    for (auto s = 0; s < StateCount; ++s) {
+        landings[space_of_state(s)] += states[s];
+    }
+}
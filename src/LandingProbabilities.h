@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Board.h"
+
+#include <array>
+#include <utility>
+#include <vector>
+
+namespace monopoly
+{
+    // How a player gets out of jail
+    enum class JailStrategy {
+        Roll,    // roll for doubles until bail is due after MaxJailTurns
+        PayBail, // pay bail at the start of the next turn and roll as usual
+    };
+
+    using SpaceTable = std::array<double, NumberOfSpaces>;
+
+    // Where a token ends up, solved exactly from the movement rules
+    //
+    // Each roll is a step of a Markov chain over the 40 spaces with a doubles
+    // streak of 0, 1 or 2, plus a state for each turn left in jail. Three doubles
+    // in a row, the Go To Jail space and the jail cards send the token to jail,
+    // and the movement cards of both decks move it on (going back three spaces
+    // can draw a second card). Every card in a deck is taken to be equally likely
+    // to be on top. A token sent to jail is counted as ending its roll on Jail.
+    class LandingProbabilities
+    {
+    public:
+        // Shared tables for each strategy, solved on first use
+        static LandingProbabilities const& get(JailStrategy strategy = JailStrategy::Roll);
+
+        explicit LandingProbabilities(JailStrategy strategy = JailStrategy::Roll);
+
+        // Chance that a roll in the long run leaves the token on each space, sums to 1
+        SpaceTable const& per_roll() const;
+        // Expected rolls per turn in the long run that leave the token on each space
+        SpaceTable const& per_turn() const;
+        double per_roll(Space space) const;
+        double per_turn(Space space) const;
+        // Expected rolls leaving the token on each space over the next turns, starting a turn on start
+        SpaceTable horizon(Space start, int turns) const;
+
+        JailStrategy get_strategy() const;
+
+    private:
+        using Distribution = std::vector<double>;
+
+        Distribution step(Distribution const& from) const;
+        void add_landings(Distribution const& states, SpaceTable& landings) const;
+
+        JailStrategy const strategy;
+        // Destination states and probabilities of one roll from each state
+        std::vector<std::vector<std::pair<int, double>>> transitions;
+        SpaceTable perRoll;
+        SpaceTable perTurn;
+    };
+}
@@ -0,0 +1,384 @@
+#include "Mcts.h"
+#include "Policies.h"
+using namespace monopoly;
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+namespace monopoly
+{
+    struct MctsNode;
+
+    struct MctsEdge
+    {
+        Input action;
+        bool chance; // rolling the dice, the outcome picks the child
+        int visits = 0;
+        int pendingVisits = 0; // workers currently playing out below this edge
+        double value = 0.0; // total reward for the player choosing the action
+        std::vector<std::pair<uint64_t, std::unique_ptr<MctsNode>>> children; // by outcome
+    };
+
+    struct MctsNode
+    {
+        int player = Player::None;
+        int visits = 0;
+        bool expanded = false;
+        std::vector<MctsEdge> edges;
+    };
+
+    struct MctsTree
+    {
+        std::mutex mutex;
+        MctsNode root;
+    };
+}
+
+namespace
+{
+    using Rewards = std::array<double, MaxPlayerCount>;
+
+    // The inputs worth searching: property management that only raises money is searched when in debt, and
+    // building or unmortgaging only at the end of a turn, so the search doesn't spend its budget on moves that
+    // undo each other. Resigning is only searched when it is the only thing to do.
+    bool worth_searching(TurnPhase phase, Input const& input) {
+        if (std::holds_alternative<ResignInput>(input)) {
+            return false;
+        }
+        if (std::holds_alternative<MortgagePropertiesInput>(input) || std::holds_alternative<SellBuildingInput>(input)
+            || std::holds_alternative<SellAllBuildingsInput>(input)) {
+            return phase == TurnPhase::WaitingForDebtSettlement;
+        }
+        if (std::holds_alternative<UnmortgagePropertiesInput>(input) || std::holds_alternative<BuyBuildingInput>(input)) {
+            return phase == TurnPhase::WaitingForTurnEnd;
+        }
+        return true;
+    }
+
+    void candidate_actions(GameState const& state, int playerIndex, ActionBuffer& buffer, std::vector<Input>& candidates) {
+        state.legal_actions(playerIndex, buffer);
+        candidates.clear();
+        auto const phase = state.get_turn_phase();
+        for (auto const& input : buffer) {
+            if (worth_searching(phase, input)) {
+                candidates.push_back(input);
+            }
+        }
+        if (candidates.empty() && !buffer.empty()) {
+            candidates.push_back(ResignInput{});
+        }
+    }
+
+    void expand(MctsNode& node, GameState const& state, ActionBuffer& buffer, std::vector<Input>& candidates) {
+        node.expanded = true;
+        node.player = state.get_controlling_player_index();
+        candidate_actions(state, node.player, buffer, candidates);
+        node.edges.reserve(candidates.size());
+        for (auto const& input : candidates) {
+            MctsEdge edge;
+            edge.action = input;
+            edge.chance = std::holds_alternative<RollInput>(input);
+            node.edges.push_back(std::move(edge));
+        }
+    }
+
+    // Identifies the outcome of a roll: the dice and the state they led to, as far as the players can see it
+    uint64_t outcome_key(GameState const& state) {
+        auto const roll = state.get_last_dice_roll();
+        return state.observed_hash() ^ static_cast<uint64_t> (roll.first * 8 + roll.second);
+    }
+
+    MctsEdge& select(MctsNode& node, double exploration, int virtualLoss) {
+        auto const parentVisits = std::max(1, node.visits);
+        auto const logVisits = std::log(static_cast<double> (parentVisits));
+        MctsEdge* best = nullptr;
+        auto bestScore = -std::numeric_limits<double>::infinity();
+        for (auto& edge : node.edges) {
+            auto const visits = edge.visits + edge.pendingVisits * virtualLoss;
+            if (visits == 0) {
+                return edge;
+            }
+            // Pending playouts count as losses until they finish
+            auto const score = edge.value / visits + exploration * std::sqrt(logVisits / visits);
+            if (score > bestScore) {
+                bestScore = score;
+                best = &edge;
+            }
+        }
+        return *best;
+    }
+
+    MctsNode& child(MctsEdge& edge, uint64_t key, bool& created) {
+        for (auto& entry : edge.children) {
+            if (entry.first == key) {
+                created = false;
+                return *entry.second;
+            }
+        }
+        created = true;
+        edge.children.emplace_back(key, std::make_unique<MctsNode>());
+        return *edge.children.back().second;
+    }
+
+    // Winners share a reward of 1, unfinished games are scored by each player's share of the net worth
+    Rewards score(GameState const& state) {
+        Rewards rewards{};
+        auto const playerCount = state.get_player_count();
+        if (state.is_game_over()) {
+            auto const winners = state.get_players_remaining_count();
+            for (auto p = 0; p < playerCount; ++p) {
+                rewards[p] = state.get_player_eliminated(p) ? 0.0 : 1.0 / winners;
+            }
+            return rewards;
+        }
+        auto total = 0.0;
+        for (auto p = 0; p < playerCount; ++p) {
+            if (!state.get_player_eliminated(p)) {
+                rewards[p] = std::max(0, state.get_net_worth(p));
+                total += rewards[p];
+            }
+        }
+        for (auto p = 0; p < playerCount; ++p) {
+            rewards[p] = total > 0.0 ? rewards[p] / total : 0.0;
+        }
+        return rewards;
+    }
+
+    void play_out(GameState& state, IPolicy& policy, int turns) {
+        auto const turnLimit = state.get_turn() + turns;
+        // Bounds the playout even if the policy keeps making inputs that don't advance the game
+        auto steps = 64 * turns;
+        while (!state.is_game_over() && state.get_turn() < turnLimit && steps-- > 0) {
+            auto const playerIndex = state.get_controlling_player_index();
+            apply_input(state, playerIndex, policy.decide(state, playerIndex));
+        }
+    }
+
+    uint32_t iteration_seed(unsigned seed, long long decision, long long iteration) {
+        uint64_t x = seed + 0x9E3779B97F4A7C15ull * static_cast<uint64_t> (decision + 1) + static_cast<uint64_t> (iteration);
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return static_cast<uint32_t> (x ^ (x >> 31));
+    }
+}
+
+MctsSearch::MctsSearch(MctsOptions options)
+    : options(std::move(options))
+    , stats()
+    , shallowSolver()
+    , rootState(nullptr)
+    , trees()
+    , nextIteration(0)
+    , completedIterations(0)
+    , deadline()
+    , searchCount(0)
+    , busyWorkers(0)
+    , stopping(false)
+{
+    for (auto t = 1; t < this->options.threadCount; ++t) {
+        workers.emplace_back(&MctsSearch::work, this, t);
+    }
+}
+
+MctsSearch::~MctsSearch() {
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        stopping = true;
+    }
+    searchStarted.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+MctsOptions const& MctsSearch::get_options() const {
+    return options;
+}
+
+MctsStats MctsSearch::get_stats() const {
+    return stats;
+}
+
+Input MctsSearch::search(GameState const& state, int playerIndex) {
+    ActionBuffer buffer;
+    std::vector<Input> candidates;
+    candidate_actions(state, playerIndex, buffer, candidates);
+    stats.decisions += 1;
+    if (candidates.size() <= 1) {
+        return candidates.empty() ? Input{ ResignInput{} } : candidates.front();
+    }
+    if (options.solveShallowDecisions) {
+        if (auto const input = shallowSolver.best_action(state)) {
+            return *input;
+        }
+    }
+
+    auto const start = std::chrono::steady_clock::now();
+    auto const threadCount = static_cast<int> (workers.size()) + 1;
+    auto const treeCount = options.parallelism == MctsParallelism::Root ? threadCount : 1;
+    trees.clear();
+    for (auto t = 0; t < treeCount; ++t) {
+        trees.push_back(std::make_unique<MctsTree>());
+    }
+    rootState = &state;
+    nextIteration = 0;
+    completedIterations = 0;
+    deadline = start + options.timeBudget;
+
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        ++searchCount;
+        busyWorkers = static_cast<int> (workers.size());
+    }
+    searchStarted.notify_all();
+    run_iterations(0);
+    {
+        std::unique_lock<std::mutex> lock(poolMutex);
+        searchFinished.wait(lock, [this]() { return busyWorkers == 0; });
+    }
+
+    // Every tree expanded its root from this state, so the edges line up with the candidates
+    std::vector<int> visits(candidates.size(), 0);
+    for (auto const& tree : trees) {
+        for (auto e = 0; e < static_cast<int> (tree->root.edges.size()); ++e) {
+            visits[e] += tree->root.edges[e].visits;
+        }
+    }
+    auto const best = std::max_element(visits.begin(), visits.end()) - visits.begin();
+    auto const choice = candidates[best];
+
+    stats.rollouts += completedIterations;
+    trees.clear();
+    rootState = nullptr;
+    return choice;
+}
+
+void MctsSearch::work(int workerIndex) {
+    unsigned lastSearch = 0;
+    std::unique_lock<std::mutex> lock(poolMutex);
+    while (true) {
+        searchStarted.wait(lock, [this, lastSearch]() { return stopping || searchCount != lastSearch; });
+        if (stopping) {
+            return;
+        }
+        lastSearch = searchCount;
+        lock.unlock();
+        run_iterations(workerIndex);
+        lock.lock();
+        if (--busyWorkers == 0) {
+            searchFinished.notify_all();
+        }
+    }
+}
+
+bool MctsSearch::claim_iteration(long long& iteration) {
+    if (options.timeBudget.count() > 0) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        iteration = nextIteration++;
+        return true;
+    }
+    iteration = nextIteration++;
+    return iteration < options.iterations;
+}
+
+void MctsSearch::run_iterations(int workerIndex) {
+    auto& tree = *trees[std::min<int>(workerIndex, static_cast<int> (trees.size()) - 1)];
+    GameState root = *rootState;
+    root.set_event_sink(nullptr);
+    GameState state = root;
+    GreedyPolicy rolloutPolicy;
+    ActionBuffer buffer;
+    std::vector<Input> candidates;
+    std::vector<std::pair<MctsNode*, MctsEdge*>> path;
+
+    long long iteration;
+    while (claim_iteration(iteration)) {
+        state = root;
+        state.force_reseed(iteration_seed(options.seed, stats.decisions, iteration));
+        state.force_shuffle_unseen_cards();
+        path.clear();
+
+        // Select and expand
+        {
+            std::lock_guard<std::mutex> lock(tree.mutex);
+            auto* node = &tree.root;
+            while (!state.is_game_over()) {
+                if (!node->expanded) {
+                    expand(*node, state, buffer, candidates);
+                }
+                if (node->edges.empty() || state.get_controlling_player_index() != node->player) {
+                    break;
+                }
+                auto& edge = select(*node, options.exploration, options.virtualLoss);
+                edge.pendingVisits += 1;
+                node->visits += 1;
+                path.emplace_back(node, &edge);
+                apply_input(state, node->player, edge.action);
+
+                auto created = false;
+                node = &child(edge, edge.chance ? outcome_key(state) : 0, created);
+                if (created) {
+                    if (!state.is_game_over()) {
+                        expand(*node, state, buffer, candidates);
+                    }
+                    break;
+                }
+            }
+        }
+
+        play_out(state, rolloutPolicy, options.rolloutTurns);
+        auto const rewards = score(state);
+
+        // Back up
+        {
+            std::lock_guard<std::mutex> lock(tree.mutex);
+            for (auto const& step : path) {
+                step.second->pendingVisits -= 1;
+                step.second->visits += 1;
+                step.second->value += rewards[step.first->player];
+            }
+        }
+        completedIterations += 1;
+    }
+}
+
+MctsPolicy::MctsPolicy(std::shared_ptr<MctsSearch> search)
+    : search(std::move(search))
+{
+}
+
+Input MctsPolicy::decide(GameState const& state, int playerIndex) {
+    return search->search(state, playerIndex);
+}
+
+namespace
+{
+    std::vector<std::unique_ptr<IPolicy>> seat_policies(std::shared_ptr<MctsSearch> const& search, int playerCount) {
+        std::vector<std::unique_ptr<IPolicy>> policies;
+        for (auto seat = 0; seat < playerCount; ++seat) {
+            policies.push_back(std::make_unique<MctsPolicy>(search));
+        }
+        return policies;
+    }
+}
+
+MctsInterface::MctsInterface(GameSetup setup, MctsOptions options)
+    : MctsInterface(std::move(setup), std::make_shared<MctsSearch>(std::move(options)))
+{
+}
+
+MctsInterface::MctsInterface(GameSetup setup, std::shared_ptr<MctsSearch> search)
+    : BotInterface(setup, seat_policies(search, setup.playerCount))
+    , search(std::move(search))
+{
+}
+
+MctsStats MctsInterface::get_stats() const {
+    return search->get_stats();
+}
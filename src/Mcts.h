@@ -0,0 +1,122 @@
+#pragma once
+
+#include "BotInterface.h"
+#include "Expectimax.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace monopoly
+{
+    enum class MctsParallelism {
+        Tree, // workers share one tree, virtual loss steers them down different lines
+        Root, // each worker grows its own tree and the visits at the root are summed
+    };
+
+    struct MctsOptions
+    {
+        // Iterations per decision, ignored if timeBudget is non-zero
+        int iterations = 1000;
+        // Time per decision
+        std::chrono::milliseconds timeBudget{ 0 };
+        // Workers, including the thread that asks for a decision
+        int threadCount = 1;
+        MctsParallelism parallelism = MctsParallelism::Tree;
+        // UCT exploration constant
+        double exploration = 1.4;
+        // Losses added to an action while a worker is playing out below it
+        int virtualLoss = 1;
+        // Playouts are stopped after this many turns and scored by each player's share of the net worth
+        int rolloutTurns = 100;
+        unsigned seed = 0;
+        // Buying and leaving jail are solved by expectimax instead of searched
+        bool solveShallowDecisions = true;
+    };
+
+    struct MctsStats
+    {
+        long long decisions = 0;
+        long long rollouts = 0;
+    };
+
+    struct MctsTree;
+
+    // Monte Carlo tree search over the legal actions of a game
+    //
+    // Each iteration descends the tree by UCT, expands one action and plays the
+    // rest of the game out with the greedy policy. Rolling the dice leads to a
+    // chance node with a child for each outcome seen, including any card drawn.
+    // Each iteration plays on a copy of the state that is reseeded, to sample
+    // the dice, and has the cards nobody has seen yet shuffled, so the search
+    // never knows the real upcoming cards.
+    //
+    // The workers are kept in a pool between decisions.
+    class MctsSearch
+    {
+    public:
+        explicit MctsSearch(MctsOptions options = {});
+        ~MctsSearch();
+        MctsSearch(MctsSearch const&) = delete;
+        MctsSearch& operator=(MctsSearch const&) = delete;
+
+        // Choose an input for playerIndex, who must be the controlling player of state
+        Input search(GameState const& state, int playerIndex);
+
+        MctsOptions const& get_options() const;
+        MctsStats get_stats() const;
+
+    private:
+        void work(int workerIndex);
+        void run_iterations(int workerIndex);
+        bool claim_iteration(long long& iteration);
+
+        MctsOptions const options;
+        MctsStats stats;
+        ExpectimaxSolver shallowSolver;
+
+        // Current search, shared by the workers
+        GameState const* rootState;
+        std::vector<std::unique_ptr<MctsTree>> trees;
+        std::atomic<long long> nextIteration;
+        std::atomic<long long> completedIterations;
+        std::chrono::steady_clock::time_point deadline;
+
+        std::mutex poolMutex;
+        std::condition_variable searchStarted;
+        std::condition_variable searchFinished;
+        unsigned searchCount;
+        int busyWorkers;
+        bool stopping;
+        std::vector<std::thread> workers;
+    };
+
+    // Plays a seat with MCTS, searches can be shared between seats
+    class MctsPolicy final : public IPolicy
+    {
+    public:
+        explicit MctsPolicy(std::shared_ptr<MctsSearch> search);
+        Input decide(GameState const& state, int playerIndex) final;
+
+    private:
+        std::shared_ptr<MctsSearch> search;
+    };
+
+    // Interface that plays every seat with one shared MCTS
+    class MctsInterface final : public BotInterface
+    {
+    public:
+        MctsInterface(GameSetup setup, MctsOptions options = {});
+
+        MctsStats get_stats() const;
+
+    private:
+        MctsInterface(GameSetup setup, std::shared_ptr<MctsSearch> search);
+
+        std::shared_ptr<MctsSearch> search;
+    };
+}
@@ -7,24 +7,27 @@
 
 namespace monopoly
 {
+    constexpr int MaxPlayerCount = 8;
+
     class Player
     {
     public:
-        static int const None = -1;
-        static int const p1 = 0;
-        static int const p2 = 1;
-        static int const p3 = 2;
-        static int const p4 = 3;
+        static constexpr int None = -1;
+        static constexpr int p1 = 0;
+        static constexpr int p2 = 1;
+        static constexpr int p3 = 2;
+        static constexpr int p4 = 3;
 
         bool eliminated = false;
         int funds = 1500;
         Space position = Space::Go;
-        std::set<Property> deeds;
+        PropertySet deeds;
         int turnsRemainingInJail = 0;
         std::set<DeckType> getOutOfJailFreeCards;
 
         inline bool operator==(Player const& rhs) const {
-            return funds == rhs.funds &&
+            return eliminated == rhs.eliminated &&
+                funds == rhs.funds &&
                 position == rhs.position &&
                 deeds == rhs.deeds &&
                 turnsRemainingInJail == rhs.turnsRemainingInJail &&
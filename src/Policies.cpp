@@ -0,0 +1,122 @@
+#include "Policies.h"
+#include "Expectimax.h"
+#include "Mcts.h"
+using namespace monopoly;
+
+#include <cstdint>
+#include <optional>
+
+namespace
+{
+    // Sell buildings before mortgaging, since a group can't be mortgaged while it has buildings on it
+    std::optional<Input> raise_funds(GameState const& state, int playerIndex) {
+        auto const deeds = state.get_player_deeds(playerIndex);
+        for (auto property : deeds) {
+            if (state.check_if_player_is_allowed_to_sell_building(playerIndex, property)) {
+                return SellBuildingInput{ property };
+            }
+        }
+        for (auto property : deeds) {
+            if (state.check_if_player_is_allowed_to_mortgage(playerIndex, property)) {
+                return MortgagePropertiesInput{ { property } };
+            }
+        }
+        return {};
+    }
+}
+
+RandomPolicy::RandomPolicy(unsigned seed)
+    : rng(seed)
+{
+}
+
+Input RandomPolicy::decide(GameState const& state, int playerIndex) {
+    state.legal_actions(playerIndex, actions);
+    // Resigning is always listed last, only pick it when there is nothing else to do
+    auto const candidateCount = actions.size() > 1 ? actions.size() - 1 : actions.size();
+    if (candidateCount == 0) {
+        return ResignInput{};
+    }
+    return actions[static_cast<int> (rng() % candidateCount)];
+}
+
+GreedyPolicy::GreedyPolicy(int cashReserve)
+    : cashReserve(cashReserve)
+{
+}
+
+Input GreedyPolicy::decide(GameState const& state, int playerIndex) {
+    switch (state.get_turn_phase()) {
+    case TurnPhase::WaitingForRoll:
+        if (state.check_if_player_is_allowed_to_use_get_out_jail_free_card(playerIndex)) {
+            return UseGetOutOfJailFreeCardInput{};
+        }
+        return RollInput{};
+    case TurnPhase::WaitingForBuyPropertyInput:
+        if (state.check_if_player_is_allowed_to_buy_property(playerIndex)) {
+            return BuyPropertyInput{};
+        }
+        return AuctionPropertyInput{};
+    case TurnPhase::WaitingForBids: {
+        auto const auction = state.get_current_auction();
+        auto const amount = auction.highestBid + 10;
+        if (amount <= price_of_property(auction.property) && state.check_if_player_is_allowed_to_bid(playerIndex, amount)) {
+            return BidInput{ amount };
+        }
+        return DeclineBidInput{};
+    }
+    case TurnPhase::WaitingForDebtSettlement:
+        if (auto const input = raise_funds(state, playerIndex)) {
+            return *input;
+        }
+        return ResignInput{};
+    case TurnPhase::WaitingForTradeOfferResponse:
+        return DeclineTradeInput{};
+    case TurnPhase::WaitingForTurnEnd:
+        for (auto property : state.get_player_deeds(playerIndex)) {
+            if (state.get_player_funds(playerIndex) - price_per_house_on_property(property) < cashReserve) {
+                continue;
+            }
+            if (state.check_if_player_is_allowed_to_buy_building(playerIndex, property)) {
+                return BuyBuildingInput{ property };
+            }
+        }
+        return EndTurnInput{};
+    case TurnPhase::WaitingForAcquisitionManagement:
+    case TurnPhase::GameOver:
+        break;
+    }
+    return ResignInput{};
+}
+
+std::vector<std::string> monopoly::policy_names() {
+    return { "greedy", "random", "expectimax", "mcts" };
+}
+
+std::unique_ptr<IPolicy> monopoly::make_policy(std::string const& name, unsigned seed) {
+    if (name == "greedy") {
+        return std::make_unique<GreedyPolicy>();
+    }
+    if (name == "random") {
+        return std::make_unique<RandomPolicy>(seed);
+    }
+    if (name == "expectimax") {
+        return std::make_unique<ExpectimaxPolicy>();
+    }
+    if (name == "mcts") {
+        MctsOptions options;
+        options.iterations = 200;
+        options.seed = seed;
+        return std::make_unique<MctsPolicy>(std::make_shared<MctsSearch>(options));
+    }
+    return nullptr;
+}
+
+unsigned monopoly::policy_seed(std::string const& gameSeed, int seat) {
+    std::vector<uint32_t> words(gameSeed.begin(), gameSeed.end());
+    words.push_back(static_cast<uint32_t> (seat));
+    std::seed_seq seedSeq(words.begin(), words.end());
+    uint32_t seed;
+    seedSeq.generate(&seed, &seed + 1);
+    return seed;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "BotInterface.h"
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace monopoly
+{
+    // Picks uniformly from the inputs that are currently allowed, only resigning when nothing else is possible
+    class RandomPolicy final : public IPolicy
+    {
+    public:
+        explicit RandomPolicy(unsigned seed = 0);
+        Input decide(GameState const& state, int playerIndex) final;
+
+    private:
+        std::minstd_rand rng;
+        ActionBuffer actions;
+    };
+
+    // Buys everything it lands on, bids up to the printed price, builds whenever it can keep a cash reserve
+    // and mortgages or sells buildings to get out of debt
+    class GreedyPolicy final : public IPolicy
+    {
+    public:
+        explicit GreedyPolicy(int cashReserve = 200);
+        Input decide(GameState const& state, int playerIndex) final;
+
+    private:
+        int const cashReserve;
+    };
+
+    // Names accepted by make_policy
+    std::vector<std::string> policy_names();
+    // Construct a policy by name, nullptr if the name is unknown
+    std::unique_ptr<IPolicy> make_policy(std::string const& name, unsigned seed = 0);
+    // Seed for the policy of a seat, mixed from the game's seed (GameSetup::seed) and the seat
+    unsigned policy_seed(std::string const& gameSeed, int seat);
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+
+namespace monopoly
+{
+    // Random number generators a game can be played with
+    enum class RngKind {
+        Mt19937, // std::mt19937, about 5KB of state, games keep the dice and shuffles they always had
+        Pcg32,   // PCG XSH RR, 16 bytes of state, cheap to copy and compare
+    };
+
+    // 32 bit permuted congruential generator (PCG XSH RR 64/32)
+    class Pcg32
+    {
+    public:
+        using result_type = uint32_t;
+        static constexpr uint64_t DefaultSequence = 0xda3e39cb94b95bdbULL;
+
+        static constexpr result_type min() {
+            return 0;
+        }
+        static constexpr result_type max() {
+            return std::numeric_limits<result_type>::max();
+        }
+
+        explicit Pcg32(uint64_t seed = 0x853c49e6748fea9bULL, uint64_t sequence = DefaultSequence) {
+            this->seed(seed, sequence);
+        }
+
+        void seed(uint64_t seed, uint64_t sequence = DefaultSequence) {
+            state = 0;
+            increment = (sequence << 1) | 1;
+            (*this)();
+            state += seed;
+            (*this)();
+        }
+
+        result_type operator()() {
+            auto const old = state;
+            state = old * 6364136223846793005ULL + increment;
+            auto const xorShifted = static_cast<uint32_t> (((old >> 18) ^ old) >> 27);
+            auto const rotation = static_cast<uint32_t> (old >> 59);
+            return (xorShifted >> rotation) | (xorShifted << ((32 - rotation) & 31));
+        }
+
+        bool operator== (Pcg32 const& rhs) const {
+            return state == rhs.state && increment == rhs.increment;
+        }
+        bool operator!= (Pcg32 const& rhs) const { return !operator== (rhs); }
+
+    private:
+        uint64_t state;
+        uint64_t increment;
+    };
+
+    // Random number generator of a game, of the kind chosen in its setup
+    //
+    // A Pcg32 is held in place. An mt19937 is held on the heap so that a game
+    // using Pcg32 doesn't carry its 5KB of state around with every copy.
+    // Assigning to an Rng that already holds an mt19937 copies into it
+    // rather than allocating another one. Moving takes the mt19937 without
+    // allocating, so a moved-from Rng must be assigned to before it is used
+    // again: until then it reports Pcg32 whatever kind it was.
+    class Rng
+    {
+    public:
+        using result_type = uint32_t;
+
+        static constexpr result_type min() {
+            return 0;
+        }
+        static constexpr result_type max() {
+            return std::numeric_limits<result_type>::max();
+        }
+
+        explicit Rng(RngKind kind = RngKind::Mt19937)
+            : pcg()
+            , mt(kind == RngKind::Mt19937 ? std::make_unique<std::mt19937>() : nullptr) {
+        }
+        Rng(Rng const& other)
+            : pcg(other.pcg)
+            , mt(other.mt ? std::make_unique<std::mt19937>(*other.mt) : nullptr) {
+        }
+        Rng& operator=(Rng const& other) {
+            pcg = other.pcg;
+            if (mt && other.mt) {
+                *mt = *other.mt;
+            }
+            else {
+                mt = other.mt ? std::make_unique<std::mt19937>(*other.mt) : nullptr;
+            }
+            return *this;
+        }
+        // Moves leave other without its mt19937, see above
+        Rng(Rng&&) = default;
+        Rng& operator=(Rng&&) = default;
+
+        // Seed from a string, as a game is seeded from GameSetup::seed
+        void seed(std::string const& seed) {
+            std::seed_seq seedSeq(seed.begin(), seed.end());
+            if (mt) {
+                mt->seed(seedSeq);
+                return;
+            }
+            uint32_t words[4];
+            seedSeq.generate(std::begin(words), std::end(words));
+            pcg.seed(uint64_t{ words[0] } << 32 | words[1], uint64_t{ words[2] } << 32 | words[3]);
+        }
+        void seed(unsigned seed) {
+            if (mt) {
+                mt->seed(seed);
+            }
+            else {
+                pcg.seed(seed);
+            }
+        }
+
+        result_type operator()() {
+            return mt ? static_cast<result_type> ((*mt)()) : pcg();
+        }
+
+        RngKind get_kind() const {
+            return mt ? RngKind::Mt19937 : RngKind::Pcg32;
+        }
+
+        bool operator== (Rng const& rhs) const {
+            if (mt || rhs.mt) {
+                return mt && rhs.mt && *mt == *rhs.mt;
+            }
+            return pcg == rhs.pcg;
+        }
+        bool operator!= (Rng const& rhs) const { return !operator== (rhs); }
+
+    private:
+        Pcg32 pcg;
+        std::unique_ptr<std::mt19937> mt; // only for RngKind::Mt19937
+    };
+}
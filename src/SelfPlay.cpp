@@ -0,0 +1,258 @@
+#include "SelfPlay.h"
+using namespace monopoly;
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+namespace
+{
+    struct ActionIndexer
+    {
+        GameState const& state;
+        int playerIndex;
+
+        int operator()(RollInput const&) const {
+            return ActionLayout::Roll;
+        }
+        int operator()(UseGetOutOfJailFreeCardInput const& input) const {
+            return ActionLayout::UseGetOutOfJailFreeCard + static_cast<int> (input.preferredDeckType);
+        }
+        int operator()(PayBailInput const&) const {
+            return ActionLayout::PayBail;
+        }
+        int operator()(BuyPropertyInput const&) const {
+            return ActionLayout::BuyProperty;
+        }
+        int operator()(AuctionPropertyInput const&) const {
+            return ActionLayout::AuctionProperty;
+        }
+        int operator()(BidInput const& input) const {
+            // Largest bucket that does not go over the raise
+            auto const raise = input.amount - state.get_current_auction().highestBid;
+            auto const& increments = ActionLayout::BidIncrements;
+            auto const bucket = std::upper_bound(increments.begin(), increments.end(), raise) - increments.begin() - 1;
+            return bucket < 0 ? -1 : ActionLayout::Bid + static_cast<int> (bucket);
+        }
+        int operator()(DeclineBidInput const&) const {
+            return ActionLayout::DeclineBid;
+        }
+        int operator()(OfferTradeInput const& input) const {
+            if (state.get_turn_phase() != TurnPhase::WaitingForTradeOfferResponse
+                || !trades_are_reciprocal(trade_from_offer_input(playerIndex, input), state.get_pending_trade_offer())) {
+                return -1;
+            }
+            return ActionLayout::AcceptTrade;
+        }
+        int operator()(DeclineTradeInput const&) const {
+            return ActionLayout::DeclineTrade;
+        }
+        int operator()(MortgagePropertiesInput const& input) const {
+            return input.properties.size() == 1 ? ActionLayout::Mortgage + static_cast<int> (input.properties.at(0)) : -1;
+        }
+        int operator()(UnmortgagePropertiesInput const& input) const {
+            return input.properties.size() == 1 ? ActionLayout::Unmortgage + static_cast<int> (input.properties.at(0)) : -1;
+        }
+        int operator()(BuyBuildingInput const& input) const {
+            return ActionLayout::BuyBuilding + static_cast<int> (input.property);
+        }
+        int operator()(SellBuildingInput const& input) const {
+            return ActionLayout::SellBuilding + static_cast<int> (input.property);
+        }
+        int operator()(EndTurnInput const&) const {
+            return ActionLayout::EndTurn;
+        }
+        int operator()(ResignInput const&) const {
+            return ActionLayout::Resign;
+        }
+        int operator()(SellAllBuildingsInput const& input) const {
+            return ActionLayout::SellAllBuildings + static_cast<int> (input.group);
+        }
+    };
+
+    std::string shard_open_error(std::string const& path) {
+        return "Unable to open shard file \"" + path + "\"";
+    }
+}
+
+int monopoly::action_index(GameState const& state, int playerIndex, Input const& input) {
+    return std::visit(ActionIndexer{ state, playerIndex }, input);
+}
+
+void monopoly::legal_action_mask(GameState const& state, int playerIndex, ActionBuffer& actions, std::array<uint64_t, ActionLayout::MaskWords>& mask) {
+    mask.fill(0);
+    actions.bidIncrements.assign(ActionLayout::BidIncrements.begin(), ActionLayout::BidIncrements.end());
+    state.legal_actions(playerIndex, actions);
+    for (auto const& input : actions) {
+        auto const index = action_index(state, playerIndex, input);
+        if (index >= 0) {
+            mask[index / 64] |= uint64_t{ 1 } << (index % 64);
+        }
+    }
+}
+
+GameRecorder::GameRecorder(int gameIndex)
+    : gameIndex(static_cast<uint32_t> (gameIndex))
+{
+}
+
+void GameRecorder::record(GameState const& state, int playerIndex, Input const& input) {
+    auto const action = action_index(state, playerIndex, input);
+    if (action < 0) {
+        return;
+    }
+    records.emplace_back();
+    auto& record = records.back();
+    std::memset(&record, 0, sizeof(record));
+    state.encode_features(record.features);
+    std::array<uint64_t, ActionLayout::MaskWords> mask;
+    legal_action_mask(state, playerIndex, actions, mask);
+    std::copy(mask.begin(), mask.end(), record.legalActions);
+    record.gameIndex = gameIndex;
+    record.turn = static_cast<uint32_t> (state.get_turn());
+    record.action = action;
+    record.playerIndex = static_cast<int8_t> (playerIndex);
+}
+
+void GameRecorder::finish(GameState const& state) {
+    for (auto& record : records) {
+        if (state.get_player_eliminated(record.playerIndex)) {
+            record.outcome = -1;
+        }
+        else {
+            record.outcome = state.is_game_over() ? 1 : 0;
+        }
+    }
+}
+
+std::vector<TrainingRecord> GameRecorder::take() {
+    return std::move(records);
+}
+
+RecordingPolicy::RecordingPolicy(std::unique_ptr<IPolicy> policy, GameRecorder& recorder)
+    : policy(std::move(policy))
+    , recorder(recorder)
+{
+}
+
+Input RecordingPolicy::decide(GameState const& state, int playerIndex) {
+    auto input = policy->decide(state, playerIndex);
+    recorder.record(state, playerIndex, input);
+    return input;
+}
+
+ShardWriter::ShardWriter(std::string const& path, int shard, int shardCount, int gameCount)
+    : file(path, std::ios::binary | std::ios::trunc)
+    , shardCount(std::max(1, shardCount))
+    , gameCount(gameCount)
+    , nextGameIndex(shard)
+    , mutex()
+    , submitted()
+    , pending()
+    , stopping(false)
+    , recordCount(0)
+    , failed(false)
+{
+    if (!file) {
+        throw std::runtime_error(shard_open_error(path));
+    }
+    // The header is written again with the counts once the games are in
+    write_header(0);
+    writer = std::thread(&ShardWriter::write_games, this);
+}
+
+ShardWriter::~ShardWriter() {
+    stop_writer();
+}
+
+void ShardWriter::submit(int gameIndex, std::vector<TrainingRecord> records) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.push_back(Submission{ gameIndex, std::move(records) });
+    }
+    submitted.notify_one();
+}
+
+void ShardWriter::finish() {
+    if (writer.joinable()) {
+        stop_writer();
+    }
+    else if (!file.is_open()) {
+        return;
+    }
+    if (!failed) {
+        auto const indexOffset = static_cast<uint64_t> (file.tellp());
+        file.write(reinterpret_cast<char const*> (index.data()), index.size() * sizeof(ShardIndexEntry));
+        file.seekp(0);
+        write_header(indexOffset);
+        file.close();
+        failed = file.fail();
+    }
+    if (failed) {
+        throw std::runtime_error("Unable to write shard file");
+    }
+}
+
+uint64_t ShardWriter::get_record_count() const {
+    return recordCount;
+}
+
+void ShardWriter::stop_writer() {
+    if (!writer.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    submitted.notify_one();
+    writer.join();
+}
+
+void ShardWriter::write_games() {
+    std::vector<Submission> taken;
+    while (nextGameIndex < gameCount) {
+        // Sleep until there is something to write, then take everything submitted so far
+        bool stop;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            submitted.wait(lock, [this] { return !pending.empty() || stopping; });
+            stop = stopping;
+            taken.swap(pending);
+        }
+        for (auto& submission : taken) {
+            waiting.emplace(submission.gameIndex, std::move(submission.records));
+        }
+        taken.clear();
+        auto wrote = false;
+        for (auto it = waiting.find(nextGameIndex); it != waiting.end(); it = waiting.find(nextGameIndex)) {
+            auto const& records = it->second;
+            index.push_back(ShardIndexEntry{ static_cast<uint32_t> (nextGameIndex), static_cast<uint32_t> (records.size()), recordCount });
+            file.write(reinterpret_cast<char const*> (records.data()), records.size() * sizeof(TrainingRecord));
+            recordCount += records.size();
+            failed = failed || file.fail();
+            waiting.erase(it);
+            nextGameIndex += shardCount;
+            wrote = true;
+        }
+        // Games that never arrive once stopping are left out, anything after them too so the shard stays in order
+        if (stop && !wrote) {
+            break;
+        }
+    }
+}
+
+void ShardWriter::write_header(uint64_t indexOffset) {
+    ShardHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::copy(std::begin(ShardHeader::MagicValue), std::end(ShardHeader::MagicValue), header.magic);
+    header.version = ShardHeader::CurrentVersion;
+    header.recordSize = sizeof(TrainingRecord);
+    header.featureStride = FeatureLayout::Stride;
+    header.actionCount = ActionLayout::Count;
+    header.gameCount = static_cast<uint32_t> (index.size());
+    header.recordCount = recordCount;
+    header.indexOffset = indexOffset;
+    file.write(reinterpret_cast<char const*> (&header), sizeof(header));
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "BotInterface.h"
+#include "GameState.h"
+#include "Input.h"
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace monopoly
+{
+    // Fixed numbering of the inputs enumerated by GameState::legal_actions, used to label training data
+    //
+    // Each entry is the offset of a block of actions. Bids are bucketed by how
+    // far they raise the highest bid, single property mortgages and
+    // building changes are numbered by property, and selling every building
+    // of a color group by group. Inputs outside this space, such as new trade
+    // offers, have no index.
+    struct ActionLayout
+    {
+        static constexpr int BidBuckets = 5;
+        static constexpr int BuildingGroups = static_cast<int> (PropertyGroup::Blue) + 1;
+        static constexpr std::array<int, BidBuckets> BidIncrements = { 1, 10, 50, 100, 250 };
+
+        static constexpr int Roll = 0;
+        static constexpr int UseGetOutOfJailFreeCard = Roll + 1;        // [deck]
+        static constexpr int PayBail = UseGetOutOfJailFreeCard + 2;
+        static constexpr int BuyProperty = PayBail + 1;
+        static constexpr int AuctionProperty = BuyProperty + 1;
+        static constexpr int Bid = AuctionProperty + 1;                 // [bid bucket]
+        static constexpr int DeclineBid = Bid + BidBuckets;
+        static constexpr int AcceptTrade = DeclineBid + 1;
+        static constexpr int DeclineTrade = AcceptTrade + 1;
+        static constexpr int Mortgage = DeclineTrade + 1;               // [property]
+        static constexpr int Unmortgage = Mortgage + PropertyCount;     // [property]
+        static constexpr int BuyBuilding = Unmortgage + PropertyCount;  // [property]
+        static constexpr int SellBuilding = BuyBuilding + PropertyCount; // [property]
+        static constexpr int SellAllBuildings = SellBuilding + PropertyCount; // [color group]
+        static constexpr int EndTurn = SellAllBuildings + BuildingGroups;
+        static constexpr int Resign = EndTurn + 1;
+        static constexpr int Count = Resign + 1;
+
+        static constexpr int MaskWords = (Count + 63) / 64;
+    };
+
+    // Index of input in ActionLayout when playerIndex makes it in state, -1 if it has none
+    int action_index(GameState const& state, int playerIndex, Input const& input);
+    // Set the bit of every legal action of playerIndex in mask, the buffer is used for the enumeration
+    void legal_action_mask(GameState const& state, int playerIndex, ActionBuffer& actions, std::array<uint64_t, ActionLayout::MaskWords>& mask);
+
+    // One decision of a self-play game, written to shards as is
+    struct TrainingRecord
+    {
+        float features[FeatureLayout::Stride];
+        uint64_t legalActions[ActionLayout::MaskWords];
+        uint32_t gameIndex;
+        uint32_t turn;
+        int32_t action;
+        int8_t playerIndex;
+        int8_t outcome; // 1 if the player won, on net worth or not, -1 if they lost, 0 if the game was stopped unfinished
+        uint8_t reserved[2];
+    };
+    static_assert(sizeof(TrainingRecord) == sizeof(float) * FeatureLayout::Stride + sizeof(uint64_t) * ActionLayout::MaskWords + 16,
+        "TrainingRecord must not have padding");
+
+    // Start of a shard file, followed by recordCount records and then gameCount index entries at indexOffset
+    struct ShardHeader
+    {
+        static constexpr char MagicValue[8] = { 'M', 'O', 'N', 'O', 'P', 'L', 'Y', 'S' };
+        static constexpr uint32_t CurrentVersion = 2;
+
+        char magic[8];
+        uint32_t version;
+        uint32_t recordSize;
+        uint32_t featureStride;
+        uint32_t actionCount;
+        uint32_t gameCount;
+        uint32_t reserved;
+        uint64_t recordCount;
+        uint64_t indexOffset;
+    };
+
+    // Where the records of one game are in a shard
+    struct ShardIndexEntry
+    {
+        uint32_t gameIndex;
+        uint32_t recordCount;
+        uint64_t firstRecord;
+    };
+
+    // Records every decision a game's policies make
+    class GameRecorder
+    {
+    public:
+        explicit GameRecorder(int gameIndex);
+
+        void record(GameState const& state, int playerIndex, Input const& input);
+        // Fill in each record's outcome from the final state
+        void finish(GameState const& state);
+        std::vector<TrainingRecord> take();
+
+    private:
+        uint32_t const gameIndex;
+        ActionBuffer actions;
+        std::vector<TrainingRecord> records;
+    };
+
+    // Plays a seat with another policy and records its decisions
+    class RecordingPolicy final : public IPolicy
+    {
+    public:
+        RecordingPolicy(std::unique_ptr<IPolicy> policy, GameRecorder& recorder);
+        Input decide(GameState const& state, int playerIndex) final;
+
+    private:
+        std::unique_ptr<IPolicy> const policy;
+        GameRecorder& recorder;
+    };
+
+    // Writes the games of one shard to a file on its own thread
+    //
+    // The shard holds games shard, shard + shardCount, shard + 2 * shardCount
+    // and so on below gameCount. Workers hand finished games over with submit,
+    // which only holds a lock to queue the game and wake the writer thread.
+    // The writer sleeps until something is submitted and writes the games in
+    // game order, so a shard's contents only depend on the games in it.
+    class ShardWriter
+    {
+    public:
+        ShardWriter(std::string const& path, int shard, int shardCount, int gameCount);
+        ~ShardWriter();
+        ShardWriter(ShardWriter const&) = delete;
+        ShardWriter& operator=(ShardWriter const&) = delete;
+
+        // Hand over the records of one of this shard's games, safe to call from any thread
+        void submit(int gameIndex, std::vector<TrainingRecord> records);
+        // Wait for the submitted games to be written, then write the index and close the file.
+        // Throws if the file could not be written.
+        void finish();
+
+        // Records written, complete once finish returns
+        uint64_t get_record_count() const;
+
+    private:
+        struct Submission
+        {
+            int gameIndex;
+            std::vector<TrainingRecord> records;
+        };
+
+        // Wake the writer thread to write what it can and wait for it to finish
+        void stop_writer();
+        void write_games();
+        void write_header(uint64_t indexOffset);
+
+        std::ofstream file;
+        int const shardCount;
+        int const gameCount;
+        int nextGameIndex;
+        std::mutex mutex;
+        std::condition_variable submitted; // signalled by submit and finish
+        std::vector<Submission> pending; // guarded by mutex
+        bool stopping;                   // guarded by mutex
+        std::map<int, std::vector<TrainingRecord>> waiting; // submitted ahead of nextGameIndex, only used by the writer
+        std::vector<ShardIndexEntry> index;
+        uint64_t recordCount;
+        bool failed;
+        std::thread writer;
+    };
+}
@@ -0,0 +1,58 @@
+#include "StateChanges.h"
+using namespace monopoly;
+
+namespace
+{
+    int get_out_of_jail_free_card_bits(GameState const& state, int playerIndex) {
+        int bits = 0;
+        for (auto deckType : state.get_player_get_out_of_jail_free_cards(playerIndex)) {
+            bits |= 1 << static_cast<int> (deckType);
+        }
+        return bits;
+    }
+}
+
+void monopoly::diff_states(GameState const& before, GameState const& after, std::vector<StateChange>& changes) {
+    using Field = StateChange::Field;
+    auto compare = [&changes](Field field, int index, int beforeValue, int afterValue) {
+        if (beforeValue != afterValue) {
+            changes.push_back(StateChange{ field, index, afterValue });
+        }
+    };
+
+    compare(Field::Turn, -1, before.get_turn(), after.get_turn());
+    compare(Field::Phase, -1, static_cast<int> (before.get_turn_phase()), static_cast<int> (after.get_turn_phase()));
+    compare(Field::ActivePlayer, -1, before.get_active_player_index(), after.get_active_player_index());
+
+    auto const playerCount = std::min(before.get_player_count(), after.get_player_count());
+    for (auto p = 0; p < playerCount; ++p) {
+        compare(Field::Funds, p, before.get_player_funds(p), after.get_player_funds(p));
+        compare(Field::Position, p, space_to_index(before.get_player_position(p)), space_to_index(after.get_player_position(p)));
+        compare(Field::TurnsRemainingInJail, p, before.get_player_turns_remaining_in_jail(p), after.get_player_turns_remaining_in_jail(p));
+        compare(Field::Eliminated, p, before.get_player_eliminated(p), after.get_player_eliminated(p));
+        compare(Field::GetOutOfJailFreeCards, p, get_out_of_jail_free_card_bits(before, p), get_out_of_jail_free_card_bits(after, p));
+    }
+
+    auto const& beforeBuildings = before.get_building_levels();
+    auto const& afterBuildings = after.get_building_levels();
+    for (auto property : all_properties()) {
+        auto const i = static_cast<int> (property);
+        compare(Field::Owner, i, before.get_property_owner_index(property), after.get_property_owner_index(property));
+        compare(Field::Mortgaged, i, before.get_property_is_mortgaged(property), after.get_property_is_mortgaged(property));
+        compare(Field::BuildingLevel, i, beforeBuildings[i], afterBuildings[i]);
+    }
+
+    auto const beforeBank = before.get_bank();
+    auto const afterBank = after.get_bank();
+    compare(Field::BankHouses, -1, beforeBank.houses, afterBank.houses);
+    compare(Field::BankHotels, -1, beforeBank.hotels, afterBank.hotels);
+
+    auto const beforeAuction = before.get_current_auction();
+    auto const afterAuction = after.get_current_auction();
+    if (beforeAuction != afterAuction || beforeAuction.property != afterAuction.property) {
+        changes.push_back(StateChange{ Field::Auction, static_cast<int> (afterAuction.property), afterAuction.highestBid });
+    }
+    if (before.get_pending_trade_offer() != after.get_pending_trade_offer()) {
+        changes.push_back(StateChange{ Field::PendingTrade });
+    }
+}
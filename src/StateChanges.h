@@ -0,0 +1,47 @@
+#pragma once
+
+#include "GameState.h"
+
+#include <vector>
+
+namespace monopoly
+{
+    // A single field of the game state that changed during a process cycle
+    //
+    // Interfaces that opt in (IInterface::wants_changes) receive the list of
+    // changes after every cycle, so a frontend or network relay can apply or
+    // forward only what changed instead of the whole state.
+    struct StateChange
+    {
+        enum class Field : uint8_t
+        {
+            Turn,                   // value is the turn number
+            Phase,                  // value is the TurnPhase
+            ActivePlayer,           // value is the active player index
+            Funds,                  // index is the player, value is their funds
+            Position,               // index is the player, value is the index of their space
+            TurnsRemainingInJail,   // index is the player, value is the turns remaining
+            Eliminated,             // index is the player, value is 1 if eliminated
+            GetOutOfJailFreeCards,  // index is the player, value has bit (1 << DeckType) set for each card held
+            Owner,                  // index is the property, value is the owner (Player::None if bank owned)
+            Mortgaged,              // index is the property, value is 1 if mortgaged
+            BuildingLevel,          // index is the property, value is the building level
+            BankHouses,             // value is the houses left in the bank
+            BankHotels,             // value is the hotels left in the bank
+            Auction,                // index is the property being auctioned (or Property::Invalid), value is the highest bid
+            PendingTrade,           // a trade offer was made, accepted or declined
+        };
+
+        Field field;
+        int index = -1;
+        int value = 0;
+
+        bool operator== (StateChange const& rhs) const {
+            return field == rhs.field && index == rhs.index && value == rhs.value;
+        }
+        bool operator!= (StateChange const& rhs) const { return !operator== (rhs); }
+    };
+
+    // Append the changes from before to after onto changes
+    void diff_states(GameState const& before, GameState const& after, std::vector<StateChange>& changes);
+}
@@ -0,0 +1,284 @@
+#include "Statistics.h"
+#include "DisplayStrings.h"
+using namespace monopoly;
+
+#include "nlohmann/json.hpp"
+using json = nlohmann::json;
+
+#include <algorithm>
+#include <iomanip>
+#include <stdexcept>
+
+namespace
+{
+    char const* cause_name(BankruptcyCause cause) {
+        switch (cause) {
+        case BankruptcyCause::Rent: return "rent";
+        case BankruptcyCause::Tax: return "tax";
+        case BankruptcyCause::Card: return "card";
+        case BankruptcyCause::Bail: return "bail";
+        case BankruptcyCause::Auction: return "auction";
+        case BankruptcyCause::Other: return "other";
+        case BankruptcyCause::Resigned: return "resigned";
+        }
+        return "other";
+    }
+
+    template <typename T>
+    void write_value(std::ostream& out, T const& value) {
+        out.write(reinterpret_cast<char const*> (&value), sizeof(value));
+    }
+
+    template <typename T>
+    void read_value(std::istream& in, T& value) {
+        in.read(reinterpret_cast<char*> (&value), sizeof(value));
+    }
+
+    double rate(long long count, long long total) {
+        return total > 0 ? static_cast<double> (count) / total : 0.0;
+    }
+
+    struct StatisticsCollector
+    {
+        GameStatistics& statistics;
+        BankruptcyCause& charge;
+        std::array<BankruptcyCause, MaxPlayerCount>& debtCauses;
+        std::array<bool, MaxPlayerCount>& inDebt;
+
+        void operator()(RolledDice const&) const {
+            charge = BankruptcyCause::Other;
+        }
+        void operator()(Landed const& e) const {
+            if (space_is_property(e.space)) {
+                statistics.landingsByProperty[static_cast<int> (space_to_property(e.space))] += 1;
+            }
+        }
+        void operator()(PaidRent const& e) const {
+            charge = BankruptcyCause::Rent;
+            statistics.rentByProperty[static_cast<int> (e.property)] += e.amount;
+        }
+        void operator()(PaidTax const&) const {
+            charge = BankruptcyCause::Tax;
+        }
+        void operator()(DrewCard const&) const {
+            charge = BankruptcyCause::Card;
+        }
+        void operator()(PaidBail const&) const {
+            charge = BankruptcyCause::Bail;
+        }
+        void operator()(MustPayBail const&) const {
+            charge = BankruptcyCause::Bail;
+        }
+        void operator()(WonAuction const& e) const {
+            charge = BankruptcyCause::Auction;
+            statistics.investedByGroup[static_cast<int> (property_group(e.property))] += e.amount;
+        }
+        void operator()(BoughtProperty const& e) const {
+            statistics.investedByGroup[static_cast<int> (property_group(e.property))] += price_of_property(e.property);
+        }
+        void operator()(BoughtBuilding const& e) const {
+            statistics.investedByGroup[static_cast<int> (property_group(e.property))] += price_per_house_on_property(e.property);
+        }
+        void operator()(IncurredDebt const& e) const {
+            debtCauses[e.debtor] = charge;
+            inDebt[e.debtor] = true;
+        }
+        void operator()(EndedTurn const&) const {
+            // A turn can't end with debts outstanding
+            inDebt.fill(false);
+        }
+        void operator()(Resigned const& e) const {
+            auto const cause = inDebt[e.player] ? debtCauses[e.player] : BankruptcyCause::Resigned;
+            statistics.bankruptcies[static_cast<int> (cause)] += 1;
+            inDebt[e.player] = false;
+        }
+        template <typename Event>
+        void operator()(Event const&) const {
+        }
+    };
+}
+
+void GameStatistics::merge(GameStatistics const& other) {
+    games += other.games;
+    unfinishedGames += other.unfinishedGames;
+    adjudicatedGames += other.adjudicatedGames;
+    if (gameLengths.size() < other.gameLengths.size()) {
+        gameLengths.resize(other.gameLengths.size(), 0);
+    }
+    for (auto i = 0u; i < other.gameLengths.size(); ++i) {
+        gameLengths[i] += other.gameLengths[i];
+    }
+    auto const add = [](auto& totals, auto const& counts) {
+        for (auto i = 0u; i < totals.size(); ++i) {
+            totals[i] += counts[i];
+        }
+    };
+    add(gamesBySeat, other.gamesBySeat);
+    add(winsBySeat, other.winsBySeat);
+    add(rentByProperty, other.rentByProperty);
+    add(landingsByProperty, other.landingsByProperty);
+    add(investedByGroup, other.investedByGroup);
+    add(bankruptcies, other.bankruptcies);
+}
+
+long long GameStatistics::rent_by_group(PropertyGroup group) const {
+    auto rent = 0ll;
+    for (auto property : properties_in_group(group)) {
+        rent += rentByProperty[static_cast<int> (property)];
+    }
+    return rent;
+}
+
+double GameStatistics::return_on_investment(PropertyGroup group) const {
+    auto const invested = investedByGroup[static_cast<int> (group)];
+    return invested > 0 ? static_cast<double> (rent_by_group(group)) / invested : 0.0;
+}
+
+std::string GameStatistics::to_json() const {
+    json j;
+    j["games"] = games;
+    j["unfinishedGames"] = unfinishedGames;
+    j["adjudicatedGames"] = adjudicatedGames;
+    j["gameLengths"] = { { "turnsPerBucket", TurnsPerBucket }, { "counts", gameLengths } };
+    j["seats"] = json::array();
+    for (auto seat = 0; seat < MaxPlayerCount && gamesBySeat[seat] > 0; ++seat) {
+        j["seats"].push_back({
+            { "seat", seat + 1 },
+            { "games", gamesBySeat[seat] },
+            { "wins", winsBySeat[seat] },
+            { "winRate", rate(winsBySeat[seat], gamesBySeat[seat]) },
+        });
+    }
+    j["properties"] = json::array();
+    for (auto i = 0; i < PropertyCount; ++i) {
+        j["properties"].push_back({
+            { "property", to_string(static_cast<Property> (i)) },
+            { "landings", landingsByProperty[i] },
+            { "rent", rentByProperty[i] },
+        });
+    }
+    j["groups"] = json::array();
+    for (auto g = 0; g < PropertyGroupCount; ++g) {
+        auto const group = static_cast<PropertyGroup> (g);
+        j["groups"].push_back({
+            { "group", to_string(group) },
+            { "invested", investedByGroup[g] },
+            { "rent", rent_by_group(group) },
+            { "returnOnInvestment", return_on_investment(group) },
+        });
+    }
+    j["bankruptcies"] = json::object();
+    for (auto c = 0; c < BankruptcyCauseCount; ++c) {
+        j["bankruptcies"][cause_name(static_cast<BankruptcyCause> (c))] = bankruptcies[c];
+    }
+    return j.dump(2);
+}
+
+void GameStatistics::write_table(std::ostream& out) const {
+    auto const flags = out.flags();
+    auto const precision = out.precision();
+    out << std::fixed << std::setprecision(2);
+
+    out << "games: " << games << ", won on net worth: " << adjudicatedGames << ", unfinished: " << unfinishedGames << "\n";
+    out << "turns      games\n";
+    for (auto i = 0u; i < gameLengths.size(); ++i) {
+        if (gameLengths[i] > 0) {
+            out << std::setw(5) << i * TurnsPerBucket << "+" << std::setw(10) << gameLengths[i] << "\n";
+        }
+    }
+    out << "seat   wins  win rate\n";
+    for (auto seat = 0; seat < MaxPlayerCount && gamesBySeat[seat] > 0; ++seat) {
+        out << std::setw(4) << seat + 1 << std::setw(7) << winsBySeat[seat]
+            << std::setw(9) << 100.0 * rate(winsBySeat[seat], gamesBySeat[seat]) << "%\n";
+    }
+    out << "group        invested        rent     ROI\n";
+    for (auto g = 0; g < PropertyGroupCount; ++g) {
+        auto const group = static_cast<PropertyGroup> (g);
+        out << std::left << std::setw(10) << to_string(group) << std::right << std::setw(12) << investedByGroup[g]
+            << std::setw(12) << rent_by_group(group) << std::setw(8) << return_on_investment(group) << "\n";
+    }
+    out << "property                  landings        rent\n";
+    for (auto i = 0; i < PropertyCount; ++i) {
+        out << std::left << std::setw(24) << to_string(static_cast<Property> (i)) << std::right
+            << std::setw(10) << landingsByProperty[i] << std::setw(12) << rentByProperty[i] << "\n";
+    }
+    out << "bankruptcy cause  players\n";
+    for (auto c = 0; c < BankruptcyCauseCount; ++c) {
+        out << std::left << std::setw(16) << cause_name(static_cast<BankruptcyCause> (c)) << std::right
+            << std::setw(9) << bankruptcies[c] << "\n";
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void GameStatistics::write(std::ostream& out) const {
+    write_value(out, games);
+    write_value(out, unfinishedGames);
+    write_value(out, adjudicatedGames);
+    write_value(out, static_cast<uint64_t> (gameLengths.size()));
+    out.write(reinterpret_cast<char const*> (gameLengths.data()), gameLengths.size() * sizeof(long long));
+    write_value(out, gamesBySeat);
+    write_value(out, winsBySeat);
+    write_value(out, rentByProperty);
+    write_value(out, landingsByProperty);
+    write_value(out, investedByGroup);
+    write_value(out, bankruptcies);
+}
+
+void GameStatistics::read(std::istream& in) {
+    read_value(in, games);
+    read_value(in, unfinishedGames);
+    read_value(in, adjudicatedGames);
+    uint64_t bucketCount = 0;
+    read_value(in, bucketCount);
+    if (!in) {
+        throw std::runtime_error("Unable to read game statistics");
+    }
+    gameLengths.assign(static_cast<std::size_t> (bucketCount), 0);
+    in.read(reinterpret_cast<char*> (gameLengths.data()), gameLengths.size() * sizeof(long long));
+    read_value(in, gamesBySeat);
+    read_value(in, winsBySeat);
+    read_value(in, rentByProperty);
+    read_value(in, landingsByProperty);
+    read_value(in, investedByGroup);
+    read_value(in, bankruptcies);
+    if (!in) {
+        throw std::runtime_error("Unable to read game statistics");
+    }
+}
+
+StatisticsSink::StatisticsSink(GameStatistics& statistics)
+    : statistics(statistics)
+    , charge(BankruptcyCause::Other)
+    , debtCauses()
+    , inDebt()
+{
+}
+
+void StatisticsSink::on_event(GameEvent const& event) {
+    std::visit(StatisticsCollector{ statistics, charge, debtCauses, inDebt }, event);
+}
+
+void StatisticsSink::finish_game(GameState const& state) {
+    statistics.games += 1;
+    auto const bucket = static_cast<std::size_t> (state.get_turn() / GameStatistics::TurnsPerBucket);
+    if (statistics.gameLengths.size() <= bucket) {
+        statistics.gameLengths.resize(bucket + 1, 0);
+    }
+    statistics.gameLengths[bucket] += 1;
+    if (!state.is_game_over()) {
+        statistics.unfinishedGames += 1;
+    }
+    else if (state.get_adjudication() != Adjudication::None) {
+        statistics.adjudicatedGames += 1;
+    }
+    for (auto seat = 0; seat < state.get_player_count(); ++seat) {
+        statistics.gamesBySeat[seat] += 1;
+        if (state.is_game_over() && !state.get_player_eliminated(seat)) {
+            statistics.winsBySeat[seat] += 1;
+        }
+    }
+    charge = BankruptcyCause::Other;
+    inDebt.fill(false);
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "GameEvents.h"
+#include "GameState.h"
+
+#include <array>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace monopoly
+{
+    constexpr int PropertyGroupCount = static_cast<int> (PropertyGroup::Railroad) + 1;
+
+    // What a player was paying when they ran out of money
+    enum class BankruptcyCause {
+        Rent,
+        Tax,
+        Card,
+        Bail,
+        Auction,
+        Other,    // any other debt, such as closing costs
+        Resigned, // resigned without owing anything
+    };
+    constexpr int BankruptcyCauseCount = static_cast<int> (BankruptcyCause::Resigned) + 1;
+
+    // Totals over many games, merged from one accumulator per thread
+    struct GameStatistics
+    {
+        static constexpr int TurnsPerBucket = 10;
+
+        long long games = 0;
+        long long unfinishedGames = 0;   // stopped without a winner
+        long long adjudicatedGames = 0;  // won on net worth at the turn or time limit
+        // Games by length, bucket i counts games of i * TurnsPerBucket up to (i + 1) * TurnsPerBucket turns
+        std::vector<long long> gameLengths;
+        std::array<long long, MaxPlayerCount> gamesBySeat{};
+        std::array<long long, MaxPlayerCount> winsBySeat{};
+        // Rent charged on each property, whether or not the player could pay it
+        std::array<long long, PropertyCount> rentByProperty{};
+        std::array<long long, PropertyCount> landingsByProperty{};
+        // Spent buying deeds from the bank, at auction, and on buildings
+        std::array<long long, PropertyGroupCount> investedByGroup{};
+        std::array<long long, BankruptcyCauseCount> bankruptcies{};
+
+        void merge(GameStatistics const& other);
+
+        long long rent_by_group(PropertyGroup group) const;
+        // Rent charged per dollar invested in the group, 0 if nothing was invested
+        double return_on_investment(PropertyGroup group) const;
+
+        std::string to_json() const;
+        void write_table(std::ostream& out) const;
+
+        // Binary form for saving and resuming a run, in the native byte order. read throws if the input is cut short.
+        void write(std::ostream& out) const;
+        void read(std::istream& in);
+    };
+
+    // Adds the events of one game at a time to statistics
+    //
+    // Set as the GameSetup::eventSink of a game, then call finish_game once it
+    // is over or stopped. A sink is meant to be used by one thread, with one
+    // sink and one GameStatistics per worker.
+    class StatisticsSink final : public IGameEventSink
+    {
+    public:
+        explicit StatisticsSink(GameStatistics& statistics);
+
+        void on_event(GameEvent const& event) final;
+        void finish_game(GameState const& state);
+
+    private:
+        GameStatistics& statistics;
+        // What the most recent charge was for, so a debt it causes can be traced back to it
+        BankruptcyCause charge;
+        std::array<BankruptcyCause, MaxPlayerCount> debtCauses;
+        std::array<bool, MaxPlayerCount> inDebt;
+    };
+}
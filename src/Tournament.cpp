@@ -0,0 +1,252 @@
+#include "Tournament.h"
+#include "BotInterface.h"
+#include "Game.h"
+using namespace monopoly;
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace
+{
+    // Tasks of one thread, taken from the front by their owner and from the back by thieves
+    class TaskDeque
+    {
+    public:
+        void push_back(int task) {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.push_back(task);
+        }
+        bool pop_front(int& task) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (tasks.empty()) {
+                return false;
+            }
+            task = tasks.front();
+            tasks.pop_front();
+            return true;
+        }
+        bool steal_back(int& task) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (tasks.empty()) {
+                return false;
+            }
+            task = tasks.back();
+            tasks.pop_back();
+            return true;
+        }
+
+    private:
+        std::mutex mutex;
+        std::deque<int> tasks;
+    };
+
+    void tally(std::vector<Standing>& standings, TournamentGame const& game) {
+        for (auto entrant : game.entrants) {
+            auto& standing = standings[entrant];
+            if (game.winner == -1) {
+                standing.draws += 1;
+                standing.halfPoints += 1;
+            }
+            else if (game.winner == entrant) {
+                standing.wins += 1;
+                standing.halfPoints += 2;
+            }
+            else {
+                standing.losses += 1;
+            }
+        }
+    }
+
+    std::vector<Standing> rank_standings(std::vector<Standing> standings) {
+        std::stable_sort(standings.begin(), standings.end(), [](Standing const& lhs, Standing const& rhs) {
+            return lhs.halfPoints > rhs.halfPoints;
+        });
+        return standings;
+    }
+}
+
+void monopoly::run_work_stealing(int taskCount, int threadCount, std::function<void(int)> const& task) {
+    threadCount = std::max(1, std::min(threadCount, taskCount));
+    if (threadCount == 1) {
+        for (auto i = 0; i < taskCount; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    std::vector<TaskDeque> deques(threadCount);
+    for (auto t = 0; t < threadCount; ++t) {
+        for (auto i = taskCount * t / threadCount; i < taskCount * (t + 1) / threadCount; ++i) {
+            deques[t].push_back(i);
+        }
+    }
+    // No task adds more tasks, so a thread that finds every deque empty is done
+    auto const next_task = [&deques, threadCount](int t, int& i) {
+        if (deques[t].pop_front(i)) {
+            return true;
+        }
+        for (auto k = 1; k < threadCount; ++k) {
+            if (deques[(t + k) % threadCount].steal_back(i)) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    std::vector<std::thread> workers;
+    for (auto t = 0; t < threadCount; ++t) {
+        workers.emplace_back([&next_task, &task, t]() {
+            for (int i; next_task(t, i);) {
+                task(i);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+Tournament::Tournament(std::vector<std::string> entrants, TournamentOptions options)
+    : entrants(std::move(entrants))
+    , options(std::move(options))
+{
+    if (this->entrants.size() < 2) {
+        throw std::invalid_argument("A tournament needs at least two entrants");
+    }
+    for (auto const& name : this->entrants) {
+        if (!make_policy(name)) {
+            throw std::invalid_argument("Unknown policy \"" + name + "\"");
+        }
+    }
+}
+
+TournamentResults Tournament::run() const {
+    auto const start = std::chrono::steady_clock::now();
+    TournamentResults results;
+    for (auto entrant = 0; entrant < get_entrant_count(); ++entrant) {
+        results.standings.push_back(Standing{ entrant });
+    }
+
+    auto const add_games = [&results](std::vector<TournamentGame> const& games) {
+        for (auto const& game : games) {
+            tally(results.standings, game);
+            results.games.push_back(game);
+        }
+    };
+
+    if (options.format == TournamentFormat::RoundRobin) {
+        std::vector<std::pair<int, int>> pairings;
+        for (auto a = 0; a < get_entrant_count(); ++a) {
+            for (auto b = a + 1; b < get_entrant_count(); ++b) {
+                pairings.emplace_back(a, b);
+            }
+        }
+        add_games(play_round(0, pairings, 0));
+    }
+    else {
+        std::vector<std::vector<bool>> played(get_entrant_count(), std::vector<bool>(get_entrant_count(), false));
+        for (auto round = 0; round < options.swissRounds; ++round) {
+            auto bye = -1;
+            auto const pairings = swiss_pairings(rank_standings(results.standings), played, bye);
+            if (bye != -1) {
+                results.standings[bye].byes += 1;
+                results.standings[bye].halfPoints += 2 * options.gamesPerPairing;
+            }
+            for (auto const& [a, b] : pairings) {
+                played[a][b] = played[b][a] = true;
+            }
+            add_games(play_round(round, pairings, static_cast<int> (results.games.size())));
+        }
+    }
+
+    results.standings = rank_standings(std::move(results.standings));
+    results.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return results;
+}
+
+std::string const& Tournament::get_entrant(int entrant) const {
+    return entrants[entrant];
+}
+
+int Tournament::get_entrant_count() const {
+    return static_cast<int> (entrants.size());
+}
+
+GameSetup Tournament::game_setup(int gameIndex) const {
+    GameSetup setup;
+    setup.seed = options.seed + ":" + std::to_string(gameIndex);
+    setup.playerCount = 2;
+    setup.rng = options.rng;
+    setup.maxTurns = options.maxTurns;
+    setup.maxWallTime = options.maxWallTime;
+    return setup;
+}
+
+std::vector<TournamentGame> Tournament::play_round(int round, std::vector<std::pair<int, int>> const& pairings, int firstGameIndex) const {
+    std::vector<TournamentGame> games;
+    for (auto const& [a, b] : pairings) {
+        for (auto g = 0; g < options.gamesPerPairing; ++g) {
+            auto const gameIndex = firstGameIndex + static_cast<int> (games.size());
+            games.push_back(g % 2 == 0 ? TournamentGame{ gameIndex, round, { a, b } } : TournamentGame{ gameIndex, round, { b, a } });
+        }
+    }
+    run_work_stealing(static_cast<int> (games.size()), options.threadCount, [this, &games](int i) {
+        play_game(games[i]);
+    });
+    return games;
+}
+
+void Tournament::play_game(TournamentGame& game) const {
+    auto const setup = game_setup(game.gameIndex);
+    std::vector<std::unique_ptr<IPolicy>> policies;
+    for (auto seat = 0; seat < 2; ++seat) {
+        policies.push_back(make_policy(entrants[game.entrants[seat]], policy_seed(setup.seed, seat)));
+    }
+    BotInterface interface(setup, std::move(policies));
+    Game g(&interface);
+
+    auto const& state = g.get_state();
+    while (!state.is_game_over()) {
+        g.process();
+    }
+    game.turns = state.get_turn();
+    game.adjudication = state.get_adjudication();
+    auto const winningSeat = state.get_winner_index();
+    game.winner = winningSeat == Player::None ? -1 : game.entrants[winningSeat];
+}
+
+std::vector<std::pair<int, int>> Tournament::swiss_pairings(std::vector<Standing> const& ranked, std::vector<std::vector<bool>> const& played, int& bye) const {
+    std::vector<int> unpaired;
+    for (auto const& standing : ranked) {
+        unpaired.push_back(standing.entrant);
+    }
+    // The lowest ranked entrant with the fewest byes sits out
+    bye = -1;
+    if (unpaired.size() % 2 == 1) {
+        auto sitting = static_cast<int> (ranked.size()) - 1;
+        for (auto i = sitting - 1; i >= 0; --i) {
+            if (ranked[i].byes < ranked[sitting].byes) {
+                sitting = i;
+            }
+        }
+        bye = ranked[sitting].entrant;
+        unpaired.erase(unpaired.begin() + sitting);
+    }
+    // Pair the best remaining entrant with the next best they haven't played, or the next best if they've played everyone
+    std::vector<std::pair<int, int>> pairings;
+    while (!unpaired.empty()) {
+        auto const a = unpaired.front();
+        unpaired.erase(unpaired.begin());
+        auto opponent = std::find_if(unpaired.begin(), unpaired.end(), [&played, a](int b) { return !played[a][b]; });
+        if (opponent == unpaired.end()) {
+            opponent = unpaired.begin();
+        }
+        pairings.emplace_back(a, *opponent);
+        unpaired.erase(opponent);
+    }
+    return pairings;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "Policies.h"
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace monopoly
+{
+    // Run task(0) to task(taskCount - 1) across threadCount threads
+    //
+    // Each thread starts with its own contiguous block of tasks and works
+    // through it from the front. A thread that runs out steals from the back
+    // of another thread's block, so long tasks at the end of one block don't
+    // leave the other threads idle.
+    void run_work_stealing(int taskCount, int threadCount, std::function<void(int)> const& task);
+
+    enum class TournamentFormat {
+        RoundRobin, // every entrant plays every other entrant
+        Swiss,      // entrants with similar scores are paired each round, without rematches where possible
+    };
+
+    struct TournamentOptions
+    {
+        std::string seed = "monopoly";
+        RngKind rng = RngKind::Mt19937;
+        TournamentFormat format = TournamentFormat::RoundRobin;
+        // Games each pairing plays, alternating who takes the first seat
+        int gamesPerPairing = 2;
+        int swissRounds = 5;
+        int threadCount = 1;
+        // Passed on as GameSetup::maxTurns and maxWallTime
+        int maxTurns = 1000;
+        std::chrono::milliseconds maxWallTime{ 0 };
+    };
+
+    // A two player game between entrants, seated in the order listed
+    struct TournamentGame
+    {
+        int gameIndex;
+        int round;
+        int entrants[2];
+        int winner = -1; // entrant, -1 for a draw
+        int turns = 0;
+        Adjudication adjudication = Adjudication::None;
+    };
+
+    struct Standing
+    {
+        int entrant;
+        int wins = 0;
+        int draws = 0;
+        int losses = 0;
+        int byes = 0;
+        // A win is worth 1 and a draw 1/2, counted in halves so that standings compare exactly. A bye is worth
+        // winning every game of a pairing.
+        int halfPoints = 0;
+
+        double score() const {
+            return halfPoints / 2.0;
+        }
+    };
+
+    struct TournamentResults
+    {
+        std::vector<TournamentGame> games; // in game index order
+        std::vector<Standing> standings;   // best first, ties broken by entrant
+        double seconds = 0.0;
+    };
+
+    // League of two player games between bot policies
+    //
+    // Every game is seeded from the master seed and its game index, and Swiss
+    // pairings only depend on the results of earlier rounds, so the results do
+    // not depend on the thread count.
+    class Tournament
+    {
+    public:
+        // Entrants are policy names accepted by make_policy, and may repeat
+        Tournament(std::vector<std::string> entrants, TournamentOptions options);
+
+        TournamentResults run() const;
+
+        std::string const& get_entrant(int entrant) const;
+        int get_entrant_count() const;
+        GameSetup game_setup(int gameIndex) const;
+
+    private:
+        // Play the games of each pairing, numbering them from firstGameIndex
+        std::vector<TournamentGame> play_round(int round, std::vector<std::pair<int, int>> const& pairings, int firstGameIndex) const;
+        void play_game(TournamentGame& game) const;
+        // Pairings for the next Swiss round from the standings so far, and the entrant sitting out if the count is odd
+        std::vector<std::pair<int, int>> swiss_pairings(std::vector<Standing> const& ranked, std::vector<std::vector<bool>> const& played, int& bye) const;
+
+        std::vector<std::string> const entrants;
+        TournamentOptions const options;
+    };
+}
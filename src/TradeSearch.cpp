@@ -0,0 +1,239 @@
+#include "TradeSearch.h"
+using namespace monopoly;
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <utility>
+
+namespace
+{
+    // Deeds that can change hands: none of the group has buildings on it
+    PropertySet tradeable_deeds(GameState const& state, int playerIndex) {
+        PropertySet ret;
+        for (auto deed : state.get_player_deeds(playerIndex)) {
+            if (state.get_max_building_level_in_group(property_group(deed)) == 0) {
+                ret.insert(deed);
+            }
+        }
+        return ret;
+    }
+
+    // Deeds of the giver in groups where the receiver already owns a deed
+    PropertySet deeds_of_interest(PropertySet giverDeeds, PropertySet receiverDeeds) {
+        PropertySet ret;
+        for (auto const& group : PropertiesByGroup) {
+            if (!(group & receiverDeeds).empty()) {
+                ret.insert(giverDeeds & group);
+            }
+        }
+        return ret;
+    }
+
+    bool completes_group(PropertySet before, PropertySet after) {
+        for (auto const& group : PropertiesByGroup) {
+            if (after.contains_all(group) && !before.contains_all(group)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Every subset of the deeds with at most maxSize deeds, including the empty set
+    std::vector<PropertySet> subsets(PropertySet deeds, int maxSize) {
+        std::vector<PropertySet> ret;
+        auto const mask = deeds.mask();
+        for (auto sub = mask;; sub = (sub - 1) & mask) {
+            if (popcount(sub) <= maxSize) {
+                ret.push_back(PropertySet::from_mask(sub));
+            }
+            if (sub == 0) {
+                break;
+            }
+        }
+        return ret;
+    }
+
+    double score(ScoredTrade const& trade) {
+        return std::min(trade.offeringGain, trade.consideringGain);
+    }
+
+    // A trade found from one of the candidate deed sets
+    struct CandidateTrade
+    {
+        size_t candidate;
+        ScoredTrade scored;
+    };
+
+    bool better(ScoredTrade const& lhs, ScoredTrade const& rhs) {
+        return score(lhs) > score(rhs);
+    }
+
+    // Equal scores go to the earlier candidate, so the trades kept don't depend on which thread scored them
+    bool better(CandidateTrade const& lhs, CandidateTrade const& rhs) {
+        auto const lhsScore = score(lhs.scored);
+        auto const rhsScore = score(rhs.scored);
+        return lhsScore != rhsScore ? lhsScore > rhsScore : lhs.candidate < rhs.candidate;
+    }
+
+    template <typename T>
+    void keep_best(std::vector<T>& best, T candidate, int topK) {
+        auto const it = std::upper_bound(best.begin(), best.end(), candidate, [](T const& lhs, T const& rhs) { return better(lhs, rhs); });
+        if (it - best.begin() < topK) {
+            best.insert(it, std::move(candidate));
+            if (static_cast<int> (best.size()) > topK) {
+                best.pop_back();
+            }
+        }
+    }
+}
+
+double GroupEquityEvaluator::evaluate(GameState const& state, Trade const& trade, int playerIndex) const {
+    auto const otherIndex = playerIndex == trade.offeringPlayer ? trade.consideringPlayer : trade.offeringPlayer;
+    auto const& given = playerIndex == trade.offeringPlayer ? trade.offer : trade.consideration;
+    auto const& received = playerIndex == trade.offeringPlayer ? trade.consideration : trade.offer;
+
+    auto const before = state.get_player_deeds(playerIndex);
+    auto const after = (before - given.deeds) | received.deeds;
+    auto const cash = received.cash - given.cash;
+    auto const gain = holdings_value(state, after, cash) - holdings_value(state, before, 0);
+
+    auto const otherBefore = state.get_player_deeds(otherIndex);
+    auto const otherAfter = (otherBefore - received.deeds) | given.deeds;
+    auto const otherGain = group_bonus(otherAfter) - group_bonus(otherBefore);
+    return gain - rivalry * otherGain;
+}
+
+double GroupEquityEvaluator::holdings_value(GameState const& state, PropertySet deeds, int cash) const {
+    auto value = static_cast<double> (cash);
+    for (auto deed : deeds) {
+        value += state.get_property_is_mortgaged(deed) ? mortgage_value_of_property(deed) : price_of_property(deed);
+    }
+    return value + group_bonus(deeds);
+}
+
+double GroupEquityEvaluator::group_bonus(PropertySet deeds) const {
+    auto bonus = 0.0;
+    for (auto const& group : PropertiesByGroup) {
+        auto const owned = (group & deeds).size();
+        if (owned == 0) {
+            continue;
+        }
+        auto const first = *group.begin();
+        if (property_is_in_group(first, PropertyGroup::Railroad)) {
+            // Rent doubles with each railroad
+            bonus += owned * (25 << (owned - 1));
+        }
+        else if (property_is_in_group(first, PropertyGroup::Utility)) {
+            bonus += owned == 2 ? 75 : 0;
+        }
+        else if (owned == group.size()) {
+            auto groupPrice = 0;
+            for (auto property : group) {
+                groupPrice += price_of_property(property);
+            }
+            bonus += completionBonus * groupPrice;
+        }
+    }
+    return bonus;
+}
+
+TradeSearch::TradeSearch(TradeSearchOptions options, std::shared_ptr<ITradeEvaluator const> evaluator)
+    : options(std::move(options))
+    , evaluator(evaluator ? std::move(evaluator) : std::make_shared<GroupEquityEvaluator>())
+{
+}
+
+std::vector<ScoredTrade> TradeSearch::search(GameState const& state, int offeringPlayer) const {
+    std::vector<ScoredTrade> best;
+    for (auto p = 0; p < state.get_player_count(); ++p) {
+        if (p == offeringPlayer || state.get_player_eliminated(p)) {
+            continue;
+        }
+        for (auto& trade : search(state, offeringPlayer, p)) {
+            keep_best(best, std::move(trade), options.topK);
+        }
+    }
+    return best;
+}
+
+std::vector<ScoredTrade> TradeSearch::search(GameState const& state, int offeringPlayer, int consideringPlayer) const {
+    auto const start = std::chrono::steady_clock::now();
+    auto const offeringDeeds = state.get_player_deeds(offeringPlayer);
+    auto const consideringDeeds = state.get_player_deeds(consideringPlayer);
+    auto const offers = subsets(deeds_of_interest(tradeable_deeds(state, offeringPlayer), consideringDeeds), options.maxDeedsPerSide);
+    auto const considerations = subsets(deeds_of_interest(tradeable_deeds(state, consideringPlayer), offeringDeeds), options.maxDeedsPerSide);
+
+    // Pairs of deed sets that complete a group for either player
+    std::vector<std::pair<PropertySet, PropertySet>> candidates;
+    for (auto const offer : offers) {
+        for (auto const consideration : considerations) {
+            if (offer.empty() && consideration.empty()) {
+                continue;
+            }
+            auto const offeringAfter = (offeringDeeds - offer) | consideration;
+            auto const consideringAfter = (consideringDeeds - consideration) | offer;
+            if (completes_group(offeringDeeds, offeringAfter) || completes_group(consideringDeeds, consideringAfter)) {
+                candidates.emplace_back(offer, consideration);
+            }
+        }
+    }
+
+    auto const threadCount = std::max(1, std::min<int>(options.threadCount, static_cast<int> (candidates.size())));
+    std::vector<std::vector<CandidateTrade>> threadBest(threadCount);
+    std::atomic<size_t> next{ 0 };
+    auto work = [&](std::vector<CandidateTrade>& best) {
+        for (auto i = next++; i < candidates.size(); i = next++) {
+            if (options.timeBudget.count() > 0 && std::chrono::steady_clock::now() - start >= options.timeBudget) {
+                return;
+            }
+            Trade trade{ offeringPlayer, consideringPlayer, {}, {} };
+            trade.offer.deeds = candidates[i].first;
+            trade.consideration.deeds = candidates[i].second;
+
+            // Balance with cash so both players share the gain
+            auto const offeringGain = evaluator->evaluate(state, trade, offeringPlayer);
+            auto const consideringGain = evaluator->evaluate(state, trade, consideringPlayer);
+            if (offeringGain + consideringGain <= 0) {
+                continue;
+            }
+            auto const step = std::max(1, options.cashStep);
+            auto const cash = static_cast<int> (std::lround((consideringGain - offeringGain) / 2 / step)) * step;
+            if (cash > 0) {
+                trade.consideration.cash = cash;
+            }
+            else if (cash < 0) {
+                trade.offer.cash = -cash;
+            }
+            if (!state.check_if_trade_is_valid(trade)) {
+                continue;
+            }
+            ScoredTrade scored{ trade, evaluator->evaluate(state, trade, offeringPlayer), evaluator->evaluate(state, trade, consideringPlayer) };
+            if (scored.offeringGain > 0 && scored.consideringGain > 0) {
+                keep_best(best, CandidateTrade{ i, std::move(scored) }, options.topK);
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (auto t = 1; t < threadCount; ++t) {
+        workers.emplace_back(work, std::ref(threadBest[t]));
+    }
+    work(threadBest[0]);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    std::vector<CandidateTrade> best;
+    for (auto& trades : threadBest) {
+        for (auto& trade : trades) {
+            keep_best(best, std::move(trade), options.topK);
+        }
+    }
+    std::vector<ScoredTrade> ret;
+    for (auto& trade : best) {
+        ret.push_back(std::move(trade.scored));
+    }
+    return ret;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "GameState.h"
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace monopoly
+{
+    // Scores a trade from the point of view of one of the players in it
+    class ITradeEvaluator
+    {
+    public:
+        virtual ~ITradeEvaluator() = default;
+        // How much better off playerIndex is after the trade, in dollars. Called from several threads at once.
+        virtual double evaluate(GameState const& state, Trade const& trade, int playerIndex) const = 0;
+    };
+
+    // Values a player's holdings as their cash, the printed (or mortgaged) value of their deeds, and a bonus for
+    // the rent multipliers of each group: completing a color group, and each additional railroad or utility
+    class GroupEquityEvaluator final : public ITradeEvaluator
+    {
+    public:
+        // Completing a color group is worth this fraction of its printed price on top
+        double completionBonus = 1.0;
+        // Strengthening the other player's groups counts against a trade by this fraction of their bonus
+        double rivalry = 0.5;
+
+        double evaluate(GameState const& state, Trade const& trade, int playerIndex) const final;
+
+        double holdings_value(GameState const& state, PropertySet deeds, int cash) const;
+        double group_bonus(PropertySet deeds) const;
+    };
+
+    struct TradeSearchOptions
+    {
+        // Most deeds either player gives up in one trade
+        int maxDeedsPerSide = 2;
+        // Number of trades returned
+        int topK = 5;
+        // Cash balancing the trade is rounded to this
+        int cashStep = 10;
+        // No limit if zero, otherwise the best trades found so far are returned
+        std::chrono::milliseconds timeBudget{ 0 };
+        int threadCount = 1;
+    };
+
+    struct ScoredTrade
+    {
+        Trade trade;
+        double offeringGain;
+        double consideringGain;
+    };
+
+    // Finds trades that leave both players better off
+    //
+    // Only deeds in groups the other player already has a stake in are
+    // offered, and a pair of deed sets is only considered if it completes a
+    // group for one of the players. Each remaining pair is balanced with cash to
+    // split the gain, kept if GameState::check_if_trade_is_valid allows it, and
+    // scored by the smaller of the two gains, ties going to the deed sets
+    // enumerated first. Get Out of Jail Free cards are not traded.
+    class TradeSearch
+    {
+    public:
+        explicit TradeSearch(TradeSearchOptions options = {}, std::shared_ptr<ITradeEvaluator const> evaluator = nullptr);
+
+        // The best trades offeringPlayer can propose to consideringPlayer, best first
+        std::vector<ScoredTrade> search(GameState const& state, int offeringPlayer, int consideringPlayer) const;
+        // The best trades offeringPlayer can propose to anyone still in the game, best first
+        std::vector<ScoredTrade> search(GameState const& state, int offeringPlayer) const;
+
+    private:
+        TradeSearchOptions const options;
+        std::shared_ptr<ITradeEvaluator const> const evaluator;
+    };
+}
@@ -15,6 +15,7 @@ namespace monopoly
     public:
         CommandLineInterface(bool automate = true)
             : IInterface()
+            , textEventSink(std::cout)
             , inputBuffer()
             , automate(automate) {
         }
@@ -22,6 +23,9 @@ namespace monopoly
         GameSetup get_setup() final {
             GameSetup setup;
             setup.playerCount = 2;
+            setup.eventSink = &textEventSink;
+            // Automated games can stall, so they are decided on net worth after a while
+            setup.maxTurns = automate ? 1000 : 0;
             return setup;
         }
 
@@ -31,7 +35,7 @@ namespace monopoly
             return ret;
         }
 
-        void update(GameState newState) final {
+        void update(GameState const& newState) final {
             state = newState;
             update_prompt();
             std::swap(prevState, state);
@@ -153,11 +157,6 @@ namespace monopoly
         }
 
         char auto_input(std::string const& options) {
-            static auto const turnLimit = 1000;
-            if (state.get_turn() > turnLimit) {
-                std::cout << "Turn limit exceeded (" << turnLimit << ")\n";
-                return quitOption;
-            }
             std::string const optionPriorities = "rbe";
             for (auto o : optionPriorities) {
                 if (options.find(o) != std::string::npos) {
@@ -228,7 +227,7 @@ namespace monopoly
             }
             std::cout << " Buildings O\n";
 
-            auto bl = state.get_building_levels();
+            auto const& bl = state.get_building_levels();
             for (auto s = 0; s < NumberOfSpaces; ++s) {
 
                 auto const space = static_cast<Space> (s);
@@ -255,7 +254,7 @@ namespace monopoly
                         std::cout << "      ";
                     }
                     else {
-                        auto const buildingLevel = bl[space_to_property(space)];
+                        int const buildingLevel = bl[static_cast<int> (property)];
                         for (auto houseSlot = 0; houseSlot < 5; ++houseSlot) {
                             auto const houseIsBuilt = (buildingLevel > houseSlot);
                             std::cout << (houseIsBuilt ? "# " : "_ ");
@@ -280,6 +279,7 @@ namespace monopoly
         }
 
         bool initialized = false;
+        TextEventSink textEventSink;
         GameState state;
         GameState prevState;
         std::queue<PlayerIndexInputPair> inputBuffer;
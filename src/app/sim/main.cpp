@@ -0,0 +1,234 @@
+#include "BatchSimulator.h"
+#include "Policies.h"
+#include "Tournament.h"
+using namespace monopoly;
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+namespace
+{
+    void print_usage(char const* program) {
+        cerr << "Usage: " << program << " [options]\n"
+            << "\t--seed <string>         master seed, each game is seeded with <seed>:<game index>\n"
+            << "\t--rng <generator>       mt19937 (default) or pcg32, which is faster to copy\n"
+            << "\t--players <n>           players per game (2-8)\n"
+            << "\t--games <n>             number of games to play\n"
+            << "\t--threads <n>           worker threads\n"
+            << "\t--max-turns <n>         games that run longer than this are won on net worth, 0 for no limit\n"
+            << "\t--max-seconds <n>       games that run longer than this are won on net worth, 0 for no limit\n"
+            << "\t--auctions <mode>       policies (each seat bids with its policy) or equity (auctions are settled at once)\n"
+            << "\t--record <directory>    write every decision to training data shards in the directory\n"
+            << "\t--shards <n>            number of shard files to record to, each with its own writer thread\n"
+            << "\t--checkpoint <file>     save progress to the file, and resume from it if it already exists\n"
+            << "\t--checkpoint-seconds <n> seconds between checkpoints (60 by default)\n"
+            << "\t--stats <format>        report statistics collected from game events, as a table or json\n"
+            << "\t--tournament <format>   play a two player league between the policies instead, roundrobin or swiss\n"
+            << "\t--pairing-games <n>     games each tournament pairing plays, alternating seats\n"
+            << "\t--rounds <n>            rounds of a swiss tournament\n"
+            << "\t--policies <a,b,...>    policy per seat, the last one fills remaining seats, or the tournament entrants (";
+        for (auto const& name : policy_names()) {
+            cerr << " " << name;
+        }
+        cerr << " )\n";
+    }
+
+    vector<string> split(string const& text, char delimiter) {
+        vector<string> ret;
+        stringstream ss(text);
+        string item;
+        while (getline(ss, item, delimiter)) {
+            ret.push_back(item);
+        }
+        return ret;
+    }
+
+    bool parse_options(int argc, char** argv, SimulationOptions& options, TournamentOptions& tournamentOptions, bool& tournament, bool& statisticsJson) {
+        for (auto i = 1; i < argc; ++i) {
+            string const arg = argv[i];
+            if (i + 1 >= argc) {
+                return false;
+            }
+            string const value = argv[++i];
+            try {
+                if (arg == "--seed") {
+                    options.seed = value;
+                }
+                else if (arg == "--rng") {
+                    if (value != "mt19937" && value != "pcg32") {
+                        return false;
+                    }
+                    options.rng = value == "pcg32" ? RngKind::Pcg32 : RngKind::Mt19937;
+                }
+                else if (arg == "--players") {
+                    options.playerCount = stoi(value);
+                }
+                else if (arg == "--games") {
+                    options.gameCount = stoi(value);
+                }
+                else if (arg == "--threads") {
+                    options.threadCount = stoi(value);
+                }
+                else if (arg == "--max-turns") {
+                    options.maxTurns = stoi(value);
+                }
+                else if (arg == "--max-seconds") {
+                    options.maxWallTime = chrono::milliseconds(static_cast<long long> (stod(value) * 1000));
+                }
+                else if (arg == "--auctions") {
+                    if (value != "policies" && value != "equity") {
+                        return false;
+                    }
+                    options.equityAuctions = value == "equity";
+                }
+                else if (arg == "--record") {
+                    options.recordDirectory = value;
+                }
+                else if (arg == "--shards") {
+                    options.shardCount = stoi(value);
+                }
+                else if (arg == "--checkpoint") {
+                    options.checkpointPath = value;
+                }
+                else if (arg == "--checkpoint-seconds") {
+                    options.checkpointInterval = chrono::seconds(stoi(value));
+                }
+                else if (arg == "--stats") {
+                    if (value != "table" && value != "json") {
+                        return false;
+                    }
+                    options.collectStatistics = true;
+                    statisticsJson = value == "json";
+                }
+                else if (arg == "--tournament") {
+                    if (value != "roundrobin" && value != "swiss") {
+                        return false;
+                    }
+                    tournament = true;
+                    tournamentOptions.format = value == "swiss" ? TournamentFormat::Swiss : TournamentFormat::RoundRobin;
+                }
+                else if (arg == "--pairing-games") {
+                    tournamentOptions.gamesPerPairing = stoi(value);
+                }
+                else if (arg == "--rounds") {
+                    tournamentOptions.swissRounds = stoi(value);
+                }
+                else if (arg == "--policies") {
+                    options.policies = split(value, ',');
+                }
+                else {
+                    return false;
+                }
+            }
+            catch (std::exception const&) {
+                return false;
+            }
+        }
+        return 2 <= options.playerCount && options.playerCount <= MaxPlayerCount
+            && options.gameCount >= 0
+            && options.maxTurns >= 0
+            && options.maxWallTime.count() >= 0
+            && options.checkpointInterval.count() >= 0
+            && options.threadCount >= 1
+            && options.shardCount >= 1
+            && tournamentOptions.gamesPerPairing >= 1
+            && tournamentOptions.swissRounds >= 1
+            && !options.policies.empty();
+    }
+
+    void print_adjudications(SimulationOptions const& options, int turnLimitGames, int wallTimeGames) {
+        cout << "won on net worth at the turn limit (" << options.maxTurns << "): " << turnLimitGames << "\n";
+        if (options.maxWallTime.count() > 0) {
+            cout << "won on net worth at the time limit (" << setprecision(3) << options.maxWallTime.count() / 1000.0 << "s): " << wallTimeGames << "\n";
+        }
+    }
+
+    void run_tournament(SimulationOptions const& options, TournamentOptions tournamentOptions) {
+        tournamentOptions.seed = options.seed;
+        tournamentOptions.rng = options.rng;
+        tournamentOptions.threadCount = options.threadCount;
+        tournamentOptions.maxTurns = options.maxTurns;
+        tournamentOptions.maxWallTime = options.maxWallTime;
+        Tournament const tournament(options.policies, tournamentOptions);
+        auto const results = tournament.run();
+
+        auto turnLimitGames = 0;
+        auto wallTimeGames = 0;
+        for (auto const& game : results.games) {
+            turnLimitGames += game.adjudication == Adjudication::TurnLimit;
+            wallTimeGames += game.adjudication == Adjudication::WallTime;
+        }
+        auto const seconds = max(results.seconds, 1e-9);
+        cout << "Played " << results.games.size() << " games between " << tournament.get_entrant_count() << " entrants ("
+            << options.threadCount << " threads) in " << fixed << setprecision(3) << seconds << "s\n";
+        cout << "games/sec: " << setprecision(1) << results.games.size() / seconds << "\n";
+        print_adjudications(options, turnLimitGames, wallTimeGames);
+        cout << "rank  entrant         score  wins draws losses byes\n";
+        for (auto rank = 0; rank < static_cast<int> (results.standings.size()); ++rank) {
+            auto const& standing = results.standings[rank];
+            cout << setw(4) << rank + 1 << "  " << left << setw(14) << (to_string(standing.entrant + 1) + ":" + tournament.get_entrant(standing.entrant)) << right
+                << setw(7) << setprecision(1) << standing.score() << setw(6) << standing.wins << setw(6) << standing.draws
+                << setw(7) << standing.losses << setw(5) << standing.byes << "\n";
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    SimulationOptions options;
+    options.threadCount = max(1u, thread::hardware_concurrency());
+    TournamentOptions tournamentOptions;
+    auto tournament = false;
+    auto statisticsJson = false;
+    if (!parse_options(argc, argv, options, tournamentOptions, tournament, statisticsJson)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    try {
+        if (tournament) {
+            run_tournament(options, tournamentOptions);
+            return 0;
+        }
+
+        BatchSimulator simulator(options);
+        auto const results = simulator.run();
+
+        auto const seconds = max(results.seconds, 1e-9);
+        cout << "Played " << results.gamesPlayed << " games (" << options.playerCount << " players, "
+            << options.threadCount << " threads) in " << fixed << setprecision(3) << seconds << "s\n";
+        cout << "games/sec: " << setprecision(1) << results.gamesPlayed / seconds << "\n";
+        cout << "turns/sec: " << setprecision(1) << results.turnsPlayed / seconds << "\n";
+        print_adjudications(options, results.adjudicatedGames - results.wallTimeGames, results.wallTimeGames);
+        if (!options.recordDirectory.empty()) {
+            cout << "recorded " << results.recordsWritten << " decisions to " << options.shardCount << " shards in " << options.recordDirectory << "\n";
+        }
+        if (!options.checkpointPath.empty()) {
+            cout << "progress saved to " << options.checkpointPath << "\n";
+        }
+        cout << "seat  policy      wins  win rate\n";
+        for (auto seat = 0; seat < options.playerCount; ++seat) {
+            auto const wins = results.winsBySeat[seat];
+            auto const rate = results.gamesPlayed > 0 ? 100.0 * wins / results.gamesPlayed : 0.0;
+            cout << setw(4) << seat + 1 << "  " << left << setw(10) << simulator.seat_policy_name(seat) << right
+                << setw(6) << wins << "  " << setw(7) << setprecision(2) << rate << "%\n";
+        }
+        if (options.collectStatistics && statisticsJson) {
+            cout << results.statistics.to_json() << "\n";
+        }
+        else if (options.collectStatistics) {
+            results.statistics.write_table(cout);
+        }
+    }
+    catch (std::exception const& e) {
+        cerr << e.what() << endl;
+        print_usage(argv[0]);
+        return 1;
+    }
+}
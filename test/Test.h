@@ -46,7 +46,7 @@ namespace monopoly
         inline void give_deed(int playerIndex, Property property) {
             change_state(std::bind(&GameState::force_give_deed, std::placeholders::_1, playerIndex, property));
         }
-        inline void give_deeds(int playerIndex, std::set<Property> properties) {
+        inline void give_deeds(int playerIndex, PropertySet properties) {
             change_state(std::bind(&GameState::force_give_deeds, std::placeholders::_1, playerIndex, properties));
         }
         inline void set_buildings(std::map<Property, int> buildingLevels) {
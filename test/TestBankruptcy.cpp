@@ -84,4 +84,19 @@ SCENARIO("When a player resigns the game should continue if there are 2 or more
             }
         }
     }
+    GIVEN("Player 1 landed on Boardwalk while in debt to the bank") {
+        test.set_player_funds(Player::p1, 0);
+        test.land_on_space(Player::p1, Space::LuxuryTax);
+        test.land_on_space(Player::p1, Space::Blue_2);
+        test.require_phase(TurnPhase::WaitingForDebtSettlement);
+
+        WHEN("player 1 resigns") {
+            test.resign(Player::p1);
+
+            THEN("the property still goes to auction") {
+                test.require_eliminated(Player::p1, true);
+                test.require_phase(TurnPhase::WaitingForBids);
+            }
+        }
+    }
 }
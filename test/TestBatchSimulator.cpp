@@ -0,0 +1,215 @@
+#include "Test.h"
+#include "BatchSimulator.h"
+#include "Policies.h"
+using namespace monopoly;
+
+#include "catch2/catch.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace
+{
+    SimulationOptions small_run() {
+        SimulationOptions options;
+        options.seed = "batch";
+        options.playerCount = 3;
+        options.gameCount = 60;
+        options.maxTurns = 300;
+        options.policies = { "greedy", "random" };
+        options.collectStatistics = true;
+        return options;
+    }
+
+    bool same_results(SimulationResults const& lhs, SimulationResults const& rhs) {
+        return lhs.gamesPlayed == rhs.gamesPlayed
+            && lhs.adjudicatedGames == rhs.adjudicatedGames
+            && lhs.wallTimeGames == rhs.wallTimeGames
+            && lhs.turnsPlayed == rhs.turnsPlayed
+            && lhs.winsBySeat == rhs.winsBySeat
+            && lhs.statistics.to_json() == rhs.statistics.to_json();
+    }
+
+    // A checkpoint file in the temporary directory, removed again at the end of the test
+    struct CheckpointFile
+    {
+        std::string const path = (std::filesystem::temp_directory_path() / "monopoly-test-checkpoint.bin").string();
+
+        CheckpointFile() {
+            std::filesystem::remove(path);
+        }
+        ~CheckpointFile() {
+            std::filesystem::remove(path);
+        }
+    };
+}
+
+SCENARIO("Batch simulation results don't depend on the thread count", "[simulator]") {
+    GIVEN("The same seed and options") {
+        auto options = small_run();
+
+        THEN("one thread and several threads play the same games") {
+            options.threadCount = 1;
+            auto const single = BatchSimulator(options).run();
+            options.threadCount = 4;
+            auto const several = BatchSimulator(options).run();
+            REQUIRE(single.gamesPlayed == options.gameCount);
+            REQUIRE(single.winsBySeat == several.winsBySeat);
+            REQUIRE(single.turnsPlayed == several.turnsPlayed);
+            REQUIRE(same_results(single, several));
+        }
+    }
+}
+
+SCENARIO("Seat policies are seeded from the game's seed", "[simulator]") {
+    GIVEN("Game seeds made from different master seeds") {
+        BatchSimulator first(small_run());
+        auto options = small_run();
+        options.seed = "another seed";
+        BatchSimulator second(options);
+        auto const firstSeed = first.game_setup(0).seed;
+        auto const secondSeed = second.game_setup(0).seed;
+
+        THEN("the same seat of the same game gets a different policy seed") {
+            REQUIRE(policy_seed(firstSeed, 0) != policy_seed(secondSeed, 0));
+        }
+        THEN("each seat gets its own seed, the same every time") {
+            REQUIRE(policy_seed(firstSeed, 0) != policy_seed(firstSeed, 1));
+            REQUIRE(policy_seed(firstSeed, 1) == policy_seed(firstSeed, 1));
+        }
+    }
+}
+
+SCENARIO("Completed games are kept as a watermark and the few games past it", "[simulator]") {
+    GIVEN("No games done") {
+        CompletedGames completed;
+        REQUIRE(completed.get_watermark() == 0);
+        REQUIRE_FALSE(completed.contains(0));
+
+        WHEN("games finish out of order") {
+            completed.add(2);
+            completed.add(1);
+
+            THEN("they wait past the watermark until every game before them is done") {
+                REQUIRE(completed.get_watermark() == 0);
+                REQUIRE(completed.get_above() == std::set<int>{ 1, 2 });
+                REQUIRE_FALSE(completed.contains(0));
+                REQUIRE(completed.contains(1));
+                REQUIRE(completed.contains(2));
+                REQUIRE_FALSE(completed.contains(3));
+            }
+            AND_WHEN("the first game finishes") {
+                completed.add(0);
+
+                THEN("the watermark moves past every game done in a row") {
+                    REQUIRE(completed.get_watermark() == 3);
+                    REQUIRE(completed.get_above().empty());
+                    REQUIRE(completed.contains(2));
+                    REQUIRE_FALSE(completed.contains(3));
+                }
+            }
+        }
+        WHEN("a game before the watermark is added again") {
+            completed.add(0);
+            completed.add(0);
+
+            THEN("nothing changes") {
+                REQUIRE(completed.get_watermark() == 1);
+                REQUIRE(completed.get_above().empty());
+            }
+        }
+    }
+}
+
+SCENARIO("Simulation checkpoints are saved and loaded", "[simulator]") {
+    CheckpointFile file;
+    SimulationCheckpoint checkpoint;
+    checkpoint.settings = "seed=checkpoint;";
+    checkpoint.completed = CompletedGames(5, { 7, 9 });
+    checkpoint.results.gamesPlayed = 7;
+    checkpoint.results.adjudicatedGames = 2;
+    checkpoint.results.wallTimeGames = 1;
+    checkpoint.results.turnsPlayed = 1234;
+    checkpoint.results.winsBySeat = { 4, 3 };
+    checkpoint.results.seconds = 1.5;
+
+    GIVEN("No checkpoint file") {
+        THEN("there is nothing to load") {
+            SimulationCheckpoint loaded;
+            REQUIRE_FALSE(loaded.load(file.path));
+        }
+    }
+    GIVEN("A saved checkpoint") {
+        checkpoint.save(file.path);
+
+        THEN("loading it gives back the same progress") {
+            SimulationCheckpoint loaded;
+            REQUIRE(loaded.load(file.path));
+            REQUIRE(loaded.settings == checkpoint.settings);
+            REQUIRE(loaded.completed.get_watermark() == 5);
+            REQUIRE(loaded.completed.get_above() == std::set<int>{ 7, 9 });
+            REQUIRE(same_results(loaded.results, checkpoint.results));
+            REQUIRE(loaded.results.seconds == checkpoint.results.seconds);
+        }
+        THEN("loading it throws wherever the file is cut short") {
+            auto const size = std::filesystem::file_size(file.path);
+            for (auto length : { std::uintmax_t{ 4 }, size / 2, size - 1 }) {
+                std::filesystem::resize_file(file.path, length);
+                SimulationCheckpoint loaded;
+                REQUIRE_THROWS_AS(loaded.load(file.path), std::runtime_error);
+            }
+        }
+        WHEN("the file is something else") {
+            std::ofstream(file.path, std::ios::binary | std::ios::trunc) << "not a checkpoint at all";
+
+            THEN("loading it throws") {
+                SimulationCheckpoint loaded;
+                REQUIRE_THROWS_AS(loaded.load(file.path), std::runtime_error);
+            }
+        }
+    }
+}
+
+SCENARIO("An interrupted batch simulation resumes from its checkpoint", "[simulator]") {
+    CheckpointFile file;
+    auto options = small_run();
+    options.threadCount = 3;
+    auto const uninterrupted = BatchSimulator(options).run();
+
+    options.checkpointPath = file.path;
+    options.checkpointInterval = std::chrono::seconds(0);
+
+    GIVEN("A checkpoint saved part of the way through the run") {
+        auto partial = options;
+        partial.gameCount = options.gameCount / 3;
+        BatchSimulator(partial).run();
+
+        SimulationCheckpoint saved;
+        REQUIRE(saved.load(file.path));
+        REQUIRE(saved.completed.get_watermark() == partial.gameCount);
+        REQUIRE(saved.results.gamesPlayed == partial.gameCount);
+
+        THEN("resuming the run ends with the results of the run that wasn't stopped") {
+            auto const resumed = BatchSimulator(options).run();
+            REQUIRE(same_results(resumed, uninterrupted));
+        }
+        THEN("resuming on a different number of threads gives the same results") {
+            options.threadCount = 1;
+            auto const resumed = BatchSimulator(options).run();
+            REQUIRE(same_results(resumed, uninterrupted));
+        }
+        THEN("resuming with different options is refused") {
+            options.seed = "another seed";
+            REQUIRE_THROWS_AS(BatchSimulator(options).run(), std::invalid_argument);
+        }
+    }
+    GIVEN("A checkpoint that can't be saved") {
+        options.checkpointPath = (std::filesystem::temp_directory_path() / "monopoly-missing-directory" / "checkpoint.bin").string();
+        options.gameCount = 10000000;
+
+        THEN("the run stops at the first failed save instead of playing every game") {
+            REQUIRE_THROWS_AS(BatchSimulator(options).run(), std::runtime_error);
+        }
+    }
+}
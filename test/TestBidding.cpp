@@ -0,0 +1,162 @@
+#include "Test.h"
+#include "Bidding.h"
+#include "BotInterface.h"
+#include "Game.h"
+#include "Policies.h"
+using namespace monopoly;
+
+#include "catch2/catch.hpp"
+
+SCENARIO("Equity tables value deeds by the groups around them", "[auction]") {
+    EquityTable const table;
+
+    GIVEN("A player with plenty of cash") {
+        auto const liquidAssets = 2000;
+
+        THEN("a deed that completes a group is worth more than one that starts it") {
+            REQUIRE(table.lookup(Property::Orange_3, 2, 0, liquidAssets) > table.lookup(Property::Orange_3, 0, 0, liquidAssets));
+        }
+        THEN("a deed that would complete an opponent's group is worth more than an untouched one") {
+            REQUIRE(table.lookup(Property::Orange_3, 0, 2, liquidAssets) > table.lookup(Property::Orange_3, 0, 0, liquidAssets));
+        }
+        THEN("a deed is worth at least its price") {
+            for (auto i = 0; i < PropertyCount; ++i) {
+                auto const property = static_cast<Property> (i);
+                REQUIRE(table.lookup(property, 0, 0, liquidAssets) >= price_of_property(property));
+            }
+        }
+    }
+    GIVEN("A player short of cash") {
+        THEN("they value the same deed less") {
+            REQUIRE(table.lookup(Property::Orange_3, 2, 0, 100) < table.lookup(Property::Orange_3, 2, 0, 2000));
+        }
+    }
+    GIVEN("A game") {
+        GameSetup setup;
+        setup.seed = "equity";
+        setup.playerCount = 2;
+        GameState state(setup);
+        state.force_give_deeds(Player::p1, { Property::Blue_1 });
+        state.force_funds(Player::p1, 150);
+
+        THEN("the maximum bid never exceeds what the player can raise") {
+            REQUIRE(table.max_bid(state, Player::p1, Property::Blue_2) <= state.calculate_liquid_assets_value(Player::p1));
+        }
+    }
+}
+
+SCENARIO("Auctions between bots are settled in one step", "[auction]") {
+    GIVEN("Two bidders with known maximum bids") {
+        Auction auction;
+        auction.property = Property::Blue_2;
+        auction.biddingOrder = { Player::p2, Player::p1 };
+        auction.highestBid = 0;
+
+        THEN("the higher maximum wins, paying just over the other") {
+            std::array<int, MaxPlayerCount> maxBids{};
+            maxBids[Player::p1] = 50;
+            maxBids[Player::p2] = 100;
+            auto const outcome = simulate_auction(auction, maxBids);
+            REQUIRE(outcome.winner == Player::p2);
+            REQUIRE(outcome.price == 51);
+        }
+        THEN("nobody bidding leaves the property with the starting bidder") {
+            std::array<int, MaxPlayerCount> maxBids{};
+            auto const outcome = simulate_auction(auction, maxBids);
+            REQUIRE(outcome.winner == Player::p1);
+            REQUIRE(outcome.price == 0);
+        }
+    }
+    GIVEN("A player auctions a property in a four player game") {
+        GameSetup setup;
+        setup.seed = "settle";
+        setup.playerCount = 4;
+        GameState state(setup);
+        state.force_give_deeds(Player::p3, { Property::Blue_1 });
+        state.force_funds(Player::p4, 120);
+        state.force_land(Player::p1, Space::Blue_2);
+        state.player_action_auction_property(Player::p1);
+        REQUIRE(state.get_turn_phase() == TurnPhase::WaitingForBids);
+
+        AuctionBidder const bidder;
+        auto const predicted = bidder.predict(state);
+
+        THEN("settling it matches bidding one raise at a time") {
+            auto settled = state;
+            bidder.settle(settled);
+
+            auto stepped = state;
+            while (stepped.get_turn_phase() == TurnPhase::WaitingForBids) {
+                auto const playerIndex = stepped.get_controlling_player_index();
+                apply_input(stepped, playerIndex, bidder.decide(stepped, playerIndex));
+            }
+
+            REQUIRE(settled.get_turn_phase() != TurnPhase::WaitingForBids);
+            REQUIRE(settled.get_property_owner_index(Property::Blue_2) == predicted.winner);
+            REQUIRE(stepped.get_property_owner_index(Property::Blue_2) == predicted.winner);
+            for (auto p = 0; p < setup.playerCount; ++p) {
+                REQUIRE(settled.get_player_funds(p) == stepped.get_player_funds(p));
+            }
+        }
+        THEN("the player completing a group wins it") {
+            REQUIRE(predicted.winner == Player::p3);
+        }
+    }
+    GIVEN("A player auctions a property that completes their own group") {
+        GameSetup setup;
+        setup.seed = "settle";
+        setup.playerCount = 3;
+        GameState state(setup);
+        state.force_give_deeds(Player::p1, { Property::Blue_1 });
+        state.force_land(Player::p1, Space::Blue_2);
+        state.player_action_auction_property(Player::p1);
+        REQUIRE(state.get_turn_phase() == TurnPhase::WaitingForBids);
+
+        AuctionBidder const bidder;
+        auto const predicted = bidder.predict(state);
+        REQUIRE(predicted.winner == Player::p1);
+        REQUIRE(state.get_current_auction().biddingOrder.back() == Player::p1);
+
+        THEN("settling it matches bidding one raise at a time, though the winner is last in the order") {
+            auto settled = state;
+            bidder.settle(settled);
+
+            auto stepped = state;
+            while (stepped.get_turn_phase() == TurnPhase::WaitingForBids) {
+                auto const playerIndex = stepped.get_controlling_player_index();
+                apply_input(stepped, playerIndex, bidder.decide(stepped, playerIndex));
+            }
+
+            REQUIRE(settled.get_turn_phase() != TurnPhase::WaitingForBids);
+            REQUIRE(settled.get_property_owner_index(Property::Blue_2) == Player::p1);
+            REQUIRE(stepped.get_property_owner_index(Property::Blue_2) == Player::p1);
+            REQUIRE(settled.get_player_funds(Player::p1) == state.get_player_funds(Player::p1) - predicted.price);
+            for (auto p = 0; p < setup.playerCount; ++p) {
+                REQUIRE(settled.get_player_funds(p) == stepped.get_player_funds(p));
+            }
+        }
+    }
+    GIVEN("A bot game that settles auctions with the bidder") {
+        GameSetup setup;
+        setup.seed = "settle";
+        setup.playerCount = 3;
+        std::vector<std::unique_ptr<IPolicy>> policies;
+        for (auto seat = 0; seat < setup.playerCount; ++seat) {
+            policies.push_back(std::make_unique<GreedyPolicy>());
+        }
+        BotInterface interface(setup, std::move(policies));
+        interface.set_auction_bidder(std::make_shared<AuctionBidder const>());
+        Game game(&interface);
+
+        THEN("each auction is over after a single cycle") {
+            auto const& state = game.get_state();
+            for (auto cycle = 0; cycle < 5000 && !state.is_game_over(); ++cycle) {
+                auto const auction = state.get_current_auction();
+                game.process();
+                if (auction) {
+                    REQUIRE(state.get_current_auction() != auction);
+                }
+            }
+        }
+    }
+}
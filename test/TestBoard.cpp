@@ -0,0 +1,114 @@
+#include "Test.h"
+#include "DisplayStrings.h"
+using namespace monopoly;
+
+#include "catch2/catch.hpp"
+
+// The board tables are constexpr, so their contents are verified when the tests are compiled
+static_assert(all_properties().size() == PropertyCount, "every property is on the board");
+static_assert(properties_in_group(PropertyGroup::Brown).size() == 2, "two brown properties");
+static_assert(properties_in_group(PropertyGroup::Railroad).size() == 4, "four railroads");
+static_assert(properties_in_group(PropertyGroup::Invalid).empty(), "no properties in the invalid group");
+static_assert(property_group(Property::Magenta_3) == PropertyGroup::Magenta, "group lookup");
+static_assert(property_group(Property::Invalid) == PropertyGroup::Invalid, "invalid group lookup");
+static_assert(property_is_in_group(Property::Utility_2, PropertyGroup::Utility), "group membership");
+
+static_assert(space_to_property(Space::Brown_1) == Property::Brown_1, "space to property");
+static_assert(space_to_property(Space::Railroad_3) == Property::Railroad_3, "space to property");
+static_assert(space_to_property(Space::Chance_2) == Property::Invalid, "card spaces aren't properties");
+static_assert(space_to_property(Space::Invalid) == Property::Invalid, "invalid space");
+static_assert(property_to_space(Property::Blue_2) == Space::Blue_2, "property to space");
+static_assert(property_to_space(Property::Utility_1) == Space::Utility_1, "property to space");
+static_assert(!space_is_property(Space::GoToJail), "go to jail isn't a property");
+
+static_assert(price_of_property(Property::Brown_1) == 60, "deed table price");
+static_assert(price_of_property(Property::Blue_2) == 400, "deed table price");
+static_assert(price_of_property(Property::Railroad_2) == 200, "railroad price");
+static_assert(price_of_property(Property::Utility_2) == 150, "utility price");
+static_assert(price_of_property(Property::Invalid) == 0, "invalid property price");
+static_assert(price_per_house_on_property(Property::Green_1) == 200, "deed table house price");
+static_assert(sell_price_per_house_on_property(Property::Green_1) == 100, "half the house price");
+static_assert(rent_price_of_real_estate(Property::Brown_2) == 4, "deed table rent");
+static_assert(rent_price_of_improved_real_estate(Property::Brown_2, 0) == 8, "monopoly doubles rent");
+static_assert(rent_price_of_improved_real_estate(Property::Blue_2, HotelLevel) == 2000, "deed table hotel rent");
+static_assert(rent_price_of_railroad(1) == 25 && rent_price_of_railroad(4) == 200, "railroad rent");
+static_assert(rent_price_of_utility(2, { 3, 4 }) == 70, "utility rent");
+static_assert(mortgage_value_of_property(Property::Red_3) == 120, "deed table mortgage");
+static_assert(unmortgage_price_of_property(Property::Brown_1) == 33, "mortgage plus interest");
+
+static_assert(distance(Space::Blue_2, Space::Go) == 1, "distance wraps around the board");
+static_assert(add_distance(Space::Blue_2, 3) == Space::CommunityChest_1, "advancing wraps around the board");
+
+SCENARIO("Property sets hold one bit per property", "[board]") {
+    GIVEN("An empty property set") {
+        PropertySet properties;
+        REQUIRE(properties.empty());
+        REQUIRE(properties.size() == 0);
+
+        WHEN("properties are inserted out of order") {
+            REQUIRE(properties.insert(Property::Railroad_4));
+            REQUIRE(properties.insert(Property::Brown_1));
+            REQUIRE(properties.insert(Property::Green_2));
+            REQUIRE_FALSE(properties.insert(Property::Brown_1));
+
+            THEN("they are iterated in property order") {
+                std::vector<Property> const ordered(properties.begin(), properties.end());
+                REQUIRE(ordered == std::vector<Property>{ Property::Brown_1, Property::Green_2, Property::Railroad_4 });
+                REQUIRE(properties.size() == 3);
+                REQUIRE(properties.at(1) == Property::Green_2);
+            }
+            THEN("they can be erased") {
+                REQUIRE(properties.erase(Property::Green_2) == 1);
+                REQUIRE(properties.erase(Property::Green_2) == 0);
+                REQUIRE(properties == PropertySet{ Property::Brown_1, Property::Railroad_4 });
+            }
+        }
+    }
+    GIVEN("The properties in each group") {
+        PropertySet groups;
+        for (auto g = 0; g <= static_cast<int> (PropertyGroup::Railroad); ++g) {
+            auto const group = static_cast<PropertyGroup> (g);
+            auto const properties = properties_in_group(group);
+            REQUIRE((groups & properties).empty());
+            groups.insert(properties);
+            for (auto property : properties) {
+                REQUIRE(property_group(property) == group);
+            }
+        }
+        THEN("every property is in exactly one group") {
+            REQUIRE(groups == all_properties());
+            REQUIRE(all_properties().size() == PropertyCount);
+            REQUIRE_FALSE(groups.contains(Property::Invalid));
+        }
+    }
+}
+
+SCENARIO("Property owners are tracked as deeds change hands", "[board]") {
+    Test test;
+    REQUIRE(test.game.get_state().get_property_owner_index(Property::Orange_1) == Player::None);
+
+    GIVEN("Player 1 owns the orange properties") {
+        test.give_deeds(Player::p1, properties_in_group(PropertyGroup::Orange));
+        REQUIRE(test.game.get_state().get_property_owner_index(Property::Orange_1) == Player::p1);
+        REQUIRE(test.game.get_state().get_properties_owned_in_group_by_player(Player::p1, PropertyGroup::Orange) == 3);
+
+        WHEN("player 1 trades one of them to player 2") {
+            test.change_state([](GameState& state) { state.force_transfer_deed(Player::p1, Player::p2, Property::Orange_1); });
+
+            THEN("player 2 is the owner") {
+                REQUIRE(test.game.get_state().get_property_owner_index(Property::Orange_1) == Player::p2);
+                REQUIRE(test.game.get_state().get_properties_owned_in_group_by_player(Player::p1, PropertyGroup::Orange) == 2);
+            }
+        }
+        WHEN("player 1 is bankrupted by the bank") {
+            test.change_state([](GameState& state) { state.force_bankrupt_by_bank(Player::p1); });
+
+            THEN("the bank owns the properties again") {
+                for (auto property : properties_in_group(PropertyGroup::Orange)) {
+                    REQUIRE(test.game.get_state().get_property_owner_index(property) == Player::None);
+                    REQUIRE(test.game.get_state().get_bank().deeds.contains(property));
+                }
+            }
+        }
+    }
+}
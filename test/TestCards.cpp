@@ -3,6 +3,7 @@ using namespace monopoly;
 
 #include "catch2/catch.hpp"
 
+#include <algorithm>
 #include <cassert>
 
 SCENARIO("A player draws a card that advances them to a specific location", "[cards]") {
@@ -247,6 +248,89 @@ SCENARIO("Players land on Community Chest throughout the game, a cyclic pattern
     }
 }
 
+SCENARIO("A deck returns drawn cards to the bottom and can have its Get Out of Jail Free card withdrawn", "[cards]") {
+    GIVEN("An unshuffled Chance deck") {
+        Deck deck(DeckType::Chance);
+        REQUIRE(deck.get_cards() == ChanceCards);
+
+        WHEN("the top card is drawn") {
+            auto const card = deck.draw();
+
+            THEN("it is placed on the bottom of the deck") {
+                REQUIRE(card == ChanceCards.front());
+                REQUIRE(deck.size() == static_cast<int> (ChanceCards.size()));
+                REQUIRE(deck.get_cards().back() == card);
+                REQUIRE(deck.get_cards().front() == ChanceCards[1]);
+            }
+        }
+        WHEN("the Get Out of Jail Free card is withdrawn and later returned") {
+            deck.remove_card(Card::Chance_GetOutOfJailFree);
+            auto const withdrawn = deck.get_cards();
+            deck.add_card(Card::Chance_GetOutOfJailFree);
+
+            THEN("the rest of the deck keeps its order and the card is returned to the bottom") {
+                REQUIRE(withdrawn.size() == ChanceCards.size() - 1);
+                REQUIRE(std::count(withdrawn.begin(), withdrawn.end(), Card::Chance_GetOutOfJailFree) == 0);
+                REQUIRE(deck.size() == static_cast<int> (ChanceCards.size()));
+                REQUIRE(deck.get_cards().back() == Card::Chance_GetOutOfJailFree);
+            }
+        }
+    }
+}
+
+SCENARIO("A deck keeps track of which cards nobody has seen", "[cards]") {
+    GIVEN("A shuffled Chance deck with three cards drawn") {
+        Rng rng(RngKind::Pcg32);
+        rng.seed(7u);
+        Deck deck(DeckType::Chance);
+        deck.shuffle(rng);
+        REQUIRE(deck.unseen_count() == deck.size());
+        for (auto i = 0; i < 3; ++i) {
+            deck.draw();
+        }
+        REQUIRE(deck.unseen_count() == deck.size() - 3);
+
+        WHEN("the unseen cards are shuffled") {
+            auto shuffled = deck;
+            shuffled.shuffle_unseen(rng);
+
+            THEN("the drawn cards stay where they are and only the hidden order changes") {
+                auto const before = deck.get_cards();
+                auto const after = shuffled.get_cards();
+                REQUIRE(std::equal(before.end() - 3, before.end(), after.end() - 3));
+                REQUIRE(std::is_permutation(before.begin(), before.end(), after.begin()));
+                REQUIRE(shuffled.unseen_count() == deck.unseen_count());
+                REQUIRE(shuffled.observed_hash() == deck.observed_hash());
+            }
+        }
+        WHEN("the same unseen cards start in a different order") {
+            auto reordered = deck;
+            auto cards = deck.get_cards();
+            std::reverse(cards.begin(), cards.end() - 3);
+            reordered.stack_deck(cards);
+            REQUIRE(reordered != deck);
+
+            THEN("shuffling them with the same generator gives the same deck") {
+                auto copy = deck;
+                auto rngCopy = rng;
+                copy.shuffle_unseen(rng);
+                reordered.shuffle_unseen(rngCopy);
+                REQUIRE(copy == reordered);
+            }
+        }
+        WHEN("the Get Out of Jail Free card is withdrawn") {
+            auto const unseen = deck.unseen_count();
+            auto const cards = deck.get_cards();
+            auto const position = std::find(cards.begin(), cards.end(), Card::Chance_GetOutOfJailFree) - cards.begin();
+            deck.remove_card(Card::Chance_GetOutOfJailFree);
+
+            THEN("it only counts against the unseen cards if it was one of them") {
+                REQUIRE(deck.unseen_count() == (position < unseen ? unseen - 1 : unseen));
+            }
+        }
+    }
+}
+
 SCENARIO("A player draws one of the building repair cards", "[cards]") {
     Test test;
     auto const startingFunds = 1500;
@@ -295,3 +379,21 @@ SCENARIO("A player draws one of the building repair cards", "[cards]") {
     }
 }
 
+
+SCENARIO("A player draws a card that pays them from the bank", "[cards]") {
+    Test test;
+    auto const startingFunds = 1500;
+    test.set_player_funds(Player::p1, startingFunds);
+
+    GIVEN("The Community Chest deck is stacked with Collect $45") {
+        test.stack_deck(DeckType::CommunityChest, { Card::CommunityChest_Gain45 });
+
+        WHEN("player 1 lands on Community Chest 1") {
+            test.land_on_space(Player::p1, Space::CommunityChest_1);
+
+            THEN("player 1 collects $45") {
+                test.require_funds(Player::p1, startingFunds + 45);
+            }
+        }
+    }
+}
@@ -0,0 +1,85 @@
+#include "Test.h"
+#include "DisplayStrings.h"
+using namespace monopoly;
+
+#include "catch2/catch.hpp"
+
+#include <sstream>
+
+namespace
+{
+    struct RecordingEventSink final : public IGameEventSink {
+        std::vector<GameEvent> events;
+
+        void on_event(GameEvent const& event) final {
+            events.push_back(event);
+        }
+
+        template<typename EVENT>
+        std::vector<EVENT> events_of_type() const {
+            std::vector<EVENT> ret;
+            for (auto const& event : events) {
+                if (auto const e = std::get_if<EVENT>(&event)) {
+                    ret.push_back(*e);
+                }
+            }
+            return ret;
+        }
+    };
+}
+
+SCENARIO("Game events are reported to the event sink", "[events]") {
+    Test test;
+    RecordingEventSink sink;
+    test.change_state([&sink](GameState& state) { state.set_event_sink(&sink); });
+
+    GIVEN("Player 2 owns " + to_string(Property::Brown_2)) {
+        test.give_deed(Player::p2, Property::Brown_2);
+
+        WHEN("player 1 lands on " + to_string(Property::Brown_2)) {
+            test.land_on_space(Player::p1, Space::Brown_2);
+
+            THEN("the landing and the rent payment are reported") {
+                auto const landed = sink.events_of_type<Landed>();
+                REQUIRE(landed.size() == 1);
+                REQUIRE(landed[0].player == Player::p1);
+                REQUIRE(landed[0].space == Space::Brown_2);
+
+                auto const paidRent = sink.events_of_type<PaidRent>();
+                REQUIRE(paidRent.size() == 1);
+                REQUIRE(paidRent[0].player == Player::p1);
+                REQUIRE(paidRent[0].owner == Player::p2);
+                REQUIRE(paidRent[0].property == Property::Brown_2);
+                REQUIRE(paidRent[0].amount == rent_price_of_real_estate(Property::Brown_2));
+            }
+        }
+    }
+    GIVEN("The player lands on an unowned property") {
+        test.land_on_space(Player::p1, Space::Brown_1);
+
+        WHEN("the player buys it") {
+            test.buy_property();
+
+            THEN("the purchase is reported") {
+                auto const bought = sink.events_of_type<BoughtProperty>();
+                REQUIRE(bought.size() == 1);
+                REQUIRE(bought[0].player == Player::p1);
+                REQUIRE(bought[0].property == Property::Brown_1);
+            }
+        }
+    }
+}
+
+SCENARIO("The text event sink narrates events one line at a time", "[events]") {
+    std::ostringstream out;
+    TextEventSink sink(out);
+
+    sink.on_event(Rolled{ Player::p1, { 3, 4 } });
+    sink.on_event(Landed{ Player::p1, Space::Brown_1 });
+    sink.on_event(PaidRent{ Player::p2, Player::p1, Property::Brown_1, 2 });
+
+    REQUIRE(out.str() ==
+        "Player 1 rolled [3] [4]\n"
+        "Player 1 landed on " + to_string(Space::Brown_1) + "\n"
+        "Player 2 pays $2 to Player 1\n");
+}
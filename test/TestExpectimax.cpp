@@ -0,0 +1,83 @@
+#include "Test.h"
+#include "Expectimax.h"
+using namespace monopoly;
+
+#include "catch2/catch.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+SCENARIO("Expectimax solves buying and leaving jail", "[expectimax]") {
+    GameSetup setup;
+    setup.seed = "expectimax";
+    setup.playerCount = 2;
+    GameState state(setup);
+    ExpectimaxSolver solver;
+
+    GIVEN("The start of the game") {
+        THEN("there is no decision for the solver") {
+            REQUIRE_FALSE(ExpectimaxSolver::handles(state));
+            REQUIRE_FALSE(solver.best_action(state).has_value());
+        }
+    }
+    GIVEN("Player 1 lands on the last property of a color group they own the rest of") {
+        state.force_give_deed(Player::p1, Property::Blue_1);
+        state.force_land(Player::p1, Space::Blue_2);
+
+        THEN("buying it is best") {
+            auto const input = solver.best_action(state);
+            REQUIRE(input.has_value());
+            REQUIRE(std::holds_alternative<BuyPropertyInput>(*input));
+        }
+        THEN("the solver leaves the state it was given untouched") {
+            auto const before = state;
+            solver.best_action(state);
+            REQUIRE(state == before);
+        }
+    }
+    GIVEN("Player 1 lands on a property they can't afford") {
+        state.force_funds(Player::p1, 100);
+        state.force_land(Player::p1, Space::Blue_2);
+
+        THEN("the only choice is to auction it") {
+            auto const input = solver.best_action(state);
+            REQUIRE(input.has_value());
+            REQUIRE(std::holds_alternative<AuctionPropertyInput>(*input));
+        }
+    }
+    GIVEN("Player 1 is in jail with a Get Out of Jail Free card") {
+        state.force_give_get_out_of_jail_free_card(Player::p1, DeckType::Chance);
+        state.force_go_to_jail(Player::p1);
+        state.force_start_turn(Player::p1);
+        REQUIRE(ExpectimaxSolver::handles(state));
+
+        THEN("the solver chooses between rolling, paying bail and using the card") {
+            auto const input = solver.best_action(state);
+            REQUIRE(input.has_value());
+            REQUIRE((std::holds_alternative<RollInput>(*input)
+                || std::holds_alternative<PayBailInput>(*input)
+                || std::holds_alternative<UseGetOutOfJailFreeCardInput>(*input)));
+        }
+        THEN("the choice doesn't depend on the order of the cards nobody has seen") {
+            auto reordered = state;
+            for (auto deckType : { DeckType::Chance, DeckType::CommunityChest }) {
+                auto cards = state.get_deck(deckType).get_cards();
+                std::reverse(cards.begin(), cards.end());
+                reordered.force_stack_deck(deckType, cards);
+            }
+            REQUIRE(reordered != state);
+            ExpectimaxOptions options;
+            options.depth = 2;
+            ExpectimaxSolver first(options);
+            ExpectimaxSolver second(options);
+            REQUIRE(first.best_action(state)->index() == second.best_action(reordered)->index());
+        }
+        THEN("solving the same position again is answered from the memo") {
+            solver.best_action(state);
+            auto const start = std::chrono::steady_clock::now();
+            solver.best_action(state);
+            auto const elapsed = std::chrono::steady_clock::now() - start;
+            REQUIRE(elapsed < std::chrono::milliseconds(5));
+        }
+    }
+}
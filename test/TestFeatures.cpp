@@ -0,0 +1,87 @@
+#include "Test.h"
+#include "GameState.h"
+using namespace monopoly;
+
+#include "catch2/catch.hpp"
+
+#include <numeric>
+
+namespace
+{
+    float block_sum(std::vector<float> const& features, int offset, int count) {
+        return std::accumulate(features.begin() + offset, features.begin() + offset + count, 0.0f);
+    }
+}
+
+SCENARIO("Game states are encoded as feature vectors", "[features]") {
+    GIVEN("A three player game in progress") {
+        GameSetup setup;
+        setup.seed = "features";
+        setup.playerCount = 3;
+        GameState state(setup);
+        state.force_give_deeds(Player::p2, { Property::Orange_1, Property::Orange_2, Property::Orange_3 });
+        state.force_set_building_levels({ { Property::Orange_1, 2 }, { Property::Orange_2, 2 }, { Property::Orange_3, 3 } });
+        state.force_give_deeds(Player::p3, { Property::Railroad_1 });
+        state.force_set_mortgaged(Property::Railroad_1, true);
+        state.force_funds(Player::p1, 1000);
+        state.force_go_to_jail(Player::p1);
+        state.force_give_get_out_of_jail_free_card(Player::p3, DeckType::Chance);
+
+        std::vector<float> features(FeatureLayout::Stride, -1.0f);
+        state.encode_features(features.data());
+
+        THEN("each seated player is on one space") {
+            for (auto p = 0; p < MaxPlayerCount; ++p) {
+                auto const expected = p < setup.playerCount ? 1.0f : 0.0f;
+                REQUIRE(block_sum(features, FeatureLayout::Position + p * NumberOfSpaces, NumberOfSpaces) == expected);
+            }
+            REQUIRE(features[FeatureLayout::Position + space_to_index(Space::Jail)] == 1.0f);
+        }
+        THEN("funds are scaled") {
+            REQUIRE(features[FeatureLayout::Funds + Player::p1] == Approx(0.5f));
+        }
+        THEN("cards are marked with their holder") {
+            REQUIRE(features[FeatureLayout::Cards + Player::p3 * 2 + static_cast<int> (DeckType::Chance)] == 1.0f);
+            REQUIRE(block_sum(features, FeatureLayout::Cards, MaxPlayerCount * 2) == 1.0f);
+        }
+        THEN("jail turns are one hot") {
+            REQUIRE(features[FeatureLayout::Jail + MaxJailTurns - 1] == 1.0f);
+            REQUIRE(block_sum(features, FeatureLayout::Jail, MaxPlayerCount * MaxJailTurns) == 1.0f);
+        }
+        THEN("every property has one owner and one building level") {
+            for (auto i = 0; i < PropertyCount; ++i) {
+                REQUIRE(block_sum(features, FeatureLayout::Owner + i * (MaxPlayerCount + 1), MaxPlayerCount + 1) == 1.0f);
+                REQUIRE(block_sum(features, FeatureLayout::Buildings + i * (HotelLevel + 1), HotelLevel + 1) == 1.0f);
+            }
+            auto const orange3 = static_cast<int> (Property::Orange_3);
+            auto const railroad1 = static_cast<int> (Property::Railroad_1);
+            REQUIRE(features[FeatureLayout::Owner + orange3 * (MaxPlayerCount + 1) + Player::p2] == 1.0f);
+            REQUIRE(features[FeatureLayout::Buildings + orange3 * (HotelLevel + 1) + 3] == 1.0f);
+            REQUIRE(features[FeatureLayout::Owner + static_cast<int> (Property::Blue_1) * (MaxPlayerCount + 1) + MaxPlayerCount] == 1.0f);
+            REQUIRE(features[FeatureLayout::Mortgaged + railroad1] == 1.0f);
+            REQUIRE(block_sum(features, FeatureLayout::Mortgaged, PropertyCount) == 1.0f);
+        }
+        THEN("the phase, deck tops and doubles streak are one hot") {
+            REQUIRE(block_sum(features, FeatureLayout::Phase, FeatureLayout::PhaseCount) == 1.0f);
+            REQUIRE(features[FeatureLayout::Phase + static_cast<int> (state.get_turn_phase())] == 1.0f);
+            REQUIRE(block_sum(features, FeatureLayout::DeckTop, Deck::Capacity) == 1.0f);
+            REQUIRE(block_sum(features, FeatureLayout::DeckTop + Deck::Capacity, Deck::Capacity) == 1.0f);
+            REQUIRE(block_sum(features, FeatureLayout::DoublesStreak, FeatureLayout::MaxDoublesStreak + 1) == 1.0f);
+        }
+        THEN("the padding is cleared") {
+            REQUIRE(block_sum(features, FeatureLayout::Size, FeatureLayout::Stride - FeatureLayout::Size) == 0.0f);
+        }
+        THEN("a batch holds the same vectors") {
+            auto other = state;
+            other.force_funds(Player::p3, 20);
+            GameState const* states[] = { &state, &other };
+            std::vector<float> batch(2 * FeatureLayout::Stride);
+            GameState::encode_features(states, 2, batch.data());
+
+            std::vector<float> otherFeatures(FeatureLayout::Stride);
+            other.encode_features(otherFeatures.data());
+            REQUIRE(std::equal(features.begin(), features.end(), batch.begin()));
+            REQUIRE(std::equal(otherFeatures.begin(), otherFeatures.end(), batch.begin() + FeatureLayout::Stride));
+        }
+    }
+}
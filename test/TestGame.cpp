@@ -0,0 +1,313 @@
+#include "Test.h"
+using namespace monopoly;
+
+#include "catch2/catch.hpp"
+
+#include <algorithm>
+
+SCENARIO("Snapshots of the game state are shared until the state changes", "[game]") {
+    Test test;
+
+    GIVEN("A snapshot of the game") {
+        auto const snapshot = test.game.snapshot();
+        REQUIRE(*snapshot == test.game.get_state());
+
+        WHEN("another snapshot is taken before the game changes") {
+            auto const sameSnapshot = test.game.snapshot();
+
+            THEN("both share the same copy") {
+                REQUIRE(sameSnapshot == snapshot);
+            }
+        }
+        WHEN("the game changes") {
+            test.set_player_funds(Player::p1, 1000);
+            auto const newSnapshot = test.game.snapshot();
+
+            THEN("the old snapshot is unchanged and a new one reflects the change") {
+                REQUIRE(snapshot->get_player_funds(Player::p1) == 1500);
+                REQUIRE(newSnapshot != snapshot);
+                REQUIRE(newSnapshot->get_player_funds(Player::p1) == 1000);
+            }
+        }
+    }
+    GIVEN("A reference to the game's state") {
+        auto const& state = test.game.get_state();
+
+        WHEN("the state is replaced, or the game started over") {
+            THEN("the reference stays valid and shows the current state") {
+                GameState replacement = state;
+                replacement.force_funds(Player::p1, 1000);
+                test.game.set_state(replacement);
+                REQUIRE(&test.game.get_state() == &state);
+                REQUIRE(state.get_player_funds(Player::p1) == 1000);
+                test.game.reset();
+                REQUIRE(&test.game.get_state() == &state);
+                REQUIRE(state.get_player_funds(Player::p1) == 1500);
+            }
+        }
+    }
+}
+
+namespace
+{
+    class ChangeRecordingInterface final : public SimpleInterface
+    {
+    public:
+        GameSetup get_setup() final {
+            GameSetup setup;
+            setup.seed = "changes";
+            setup.playerCount = 2;
+            return setup;
+        }
+        void update(GameState const& state) final {
+        }
+        bool wants_changes() const final {
+            return true;
+        }
+        void on_changes(std::vector<StateChange> const& newChanges) final {
+            changes.push_back(newChanges);
+        }
+
+        std::vector<std::vector<StateChange>> changes;
+    };
+}
+
+SCENARIO("Interfaces can receive only the fields that changed in each cycle", "[game]") {
+    ChangeRecordingInterface interface;
+    Game game(&interface);
+
+    WHEN("nothing happens during a cycle") {
+        game.process();
+
+        THEN("no changes are reported") {
+            REQUIRE(interface.changes.empty());
+        }
+    }
+    WHEN("player 1 rolls the dice") {
+        interface.roll_dice(Player::p1);
+        game.process();
+
+        THEN("their new position is reported") {
+            REQUIRE(interface.changes.size() == 1);
+            auto const& changes = interface.changes.front();
+            auto const newPosition = space_to_index(game.get_state().get_player_position(Player::p1));
+            REQUIRE(std::count(changes.begin(), changes.end(), StateChange{ StateChange::Field::Position, Player::p1, newPosition }) == 1);
+            REQUIRE(std::none_of(changes.begin(), changes.end(), [](StateChange const& change) {
+                return change.field == StateChange::Field::Position && change.index == Player::p2;
+            }));
+        }
+    }
+}
+
+namespace
+{
+    template <typename T>
+    int count_actions(ActionBuffer const& actions) {
+        auto count = 0;
+        for (auto const& input : actions) {
+            count += std::holds_alternative<T>(input) ? 1 : 0;
+        }
+        return count;
+    }
+}
+
+SCENARIO("Every legal input for a player can be enumerated into a reusable buffer", "[game]") {
+    Test test;
+    ActionBuffer actions;
+
+    GIVEN("The start of player 1's turn") {
+        test.game.get_state().legal_actions(Player::p1, actions);
+
+        THEN("player 1 can only roll or resign, and resigning is listed last") {
+            REQUIRE(actions.size() == 2);
+            REQUIRE(std::holds_alternative<RollInput>(actions[0]));
+            REQUIRE(std::holds_alternative<ResignInput>(actions[1]));
+        }
+        THEN("player 2 has nothing to do") {
+            test.game.get_state().legal_actions(Player::p2, actions);
+            REQUIRE(actions.empty());
+        }
+    }
+    GIVEN("Player 1 owns a property and lands on an unowned one") {
+        test.give_deed(Player::p1, Property::Brown_1);
+        test.land_on_space(Player::p1, Space::Blue_2);
+        test.game.get_state().legal_actions(Player::p1, actions);
+
+        THEN("they can buy it, auction it, or mortgage what they own") {
+            REQUIRE(count_actions<BuyPropertyInput>(actions) == 1);
+            REQUIRE(count_actions<AuctionPropertyInput>(actions) == 1);
+            REQUIRE(count_actions<MortgagePropertiesInput>(actions) == 1);
+            REQUIRE(count_actions<RollInput>(actions) == 0);
+        }
+        WHEN("the property is auctioned and player 2 has $60") {
+            test.set_player_funds(Player::p2, 60);
+            test.auction_property();
+            test.game.get_state().legal_actions(Player::p2, actions);
+
+            THEN("player 2 may decline or bid each increment they can afford") {
+                REQUIRE(count_actions<DeclineBidInput>(actions) == 1);
+                REQUIRE(count_actions<BidInput>(actions) == 3);
+                REQUIRE(std::get<BidInput>(actions[0]).amount == 1);
+                REQUIRE(std::get<BidInput>(actions[2]).amount == 50);
+            }
+        }
+    }
+    GIVEN("Player 1 has houses on a color group") {
+        test.give_deeds(Player::p1, { Property::Brown_1, Property::Brown_2, Property::Red_1 });
+        test.set_buildings({ { Property::Brown_1, 2 }, { Property::Brown_2, 1 } });
+        test.game.get_state().legal_actions(Player::p1, actions);
+
+        THEN("they can sell every building of that group at once") {
+            REQUIRE(count_actions<SellAllBuildingsInput>(actions) == 1);
+            auto const sellAll = std::find_if(actions.begin(), actions.end(), [](Input const& input) {
+                return std::holds_alternative<SellAllBuildingsInput>(input);
+            });
+            REQUIRE(std::get<SellAllBuildingsInput>(*sellAll).group == PropertyGroup::Brown);
+        }
+    }
+}
+
+SCENARIO("Player actions can be undone to restore the exact state from before them", "[game, undo]") {
+    GameSetup setup;
+    setup.seed = "undo";
+    GameState state(setup);
+    state.set_journaling(true);
+
+    GIVEN("A long line of random legal actions") {
+        std::minstd_rand rng(7);
+        ActionBuffer actions;
+        std::vector<GameState> history;
+        while (history.size() < 150 && !state.is_game_over()) {
+            auto const playerIndex = state.get_controlling_player_index();
+            state.legal_actions(playerIndex, actions);
+            // Leave out resigning so the game runs long enough to cover auctions, debts and trades
+            auto const choices = actions.size() > 1 ? actions.size() - 1 : actions.size();
+            history.push_back(state);
+            auto const depth = state.get_undo_depth();
+            apply_input(state, playerIndex, actions[static_cast<int> (rng() % choices)]);
+            REQUIRE(state.get_undo_depth() == depth + 1);
+        }
+
+        WHEN("every action is undone") {
+            THEN("each earlier state is restored exactly") {
+                while (!history.empty()) {
+                    state.undo();
+                    REQUIRE(state == history.back());
+                    REQUIRE(state.hash() == history.back().hash());
+                    for (auto property : all_properties()) {
+                        REQUIRE(state.get_property_owner_index(property) == history.back().get_property_owner_index(property));
+                        REQUIRE(state.calculate_rent(property) == history.back().calculate_rent(property));
+                    }
+                    history.pop_back();
+                }
+                REQUIRE(state.get_undo_depth() == 0);
+            }
+        }
+    }
+}
+
+SCENARIO("The state hash is kept up to date by every change to the state", "[game, hash]") {
+    GameSetup setup;
+    setup.seed = "hash";
+    GameState state(setup);
+
+    GIVEN("A new game") {
+        THEN("the hash matches a full recompute") {
+            REQUIRE(state.hash() == state.recompute_hash());
+        }
+        THEN("a game with the same seed has the same hash") {
+            REQUIRE(GameState(setup).hash() == state.hash());
+        }
+        THEN("a game with differently shuffled decks has a different hash") {
+            setup.seed = "other";
+            REQUIRE(GameState(setup).hash() != state.hash());
+        }
+    }
+    GIVEN("A change to the board") {
+        auto const before = state.hash();
+        state.force_give_deeds(Player::p1, { Property::Brown_1, Property::Brown_2 });
+        state.force_set_mortgaged(Property::Brown_1, true);
+        state.force_add_building(Property::Brown_2);
+        REQUIRE(state.hash() != before);
+        REQUIRE(state.hash() == state.recompute_hash());
+
+        WHEN("the building and mortgage are removed") {
+            auto const owned = state.hash();
+            state.force_set_mortgaged(Property::Brown_1, false);
+            state.force_add_building(Property::Brown_2);
+            state.force_remove_building(Property::Brown_2);
+            state.force_remove_building(Property::Brown_2);
+            THEN("the hash only differs by the owners") {
+                REQUIRE(state.hash() != owned);
+                REQUIRE(state.hash() == state.recompute_hash());
+                GameState fresh(setup);
+                fresh.force_give_deeds(Player::p1, { Property::Brown_1, Property::Brown_2 });
+                REQUIRE(state.hash() == fresh.hash());
+            }
+        }
+    }
+    GIVEN("A long line of random legal actions") {
+        std::minstd_rand rng(11);
+        ActionBuffer actions;
+        for (auto i = 0; i < 2000 && !state.is_game_over(); ++i) {
+            auto const playerIndex = state.get_controlling_player_index();
+            state.legal_actions(playerIndex, actions);
+            auto const choices = actions.size() > 1 ? actions.size() - 1 : actions.size();
+            apply_input(state, playerIndex, actions[static_cast<int> (rng() % choices)]);
+            REQUIRE(state.hash() == state.recompute_hash());
+        }
+    }
+}
+
+SCENARIO("Games that reach their turn limit are won on net worth", "[game, adjudication]") {
+    GameSetup setup;
+    setup.seed = "adjudication";
+    setup.playerCount = 3;
+    setup.maxTurns = 20;
+    GameState state(setup);
+    state.set_journaling(true);
+
+    GIVEN("Players that never resign") {
+        std::minstd_rand rng(3);
+        ActionBuffer actions;
+        GameState before;
+        while (!state.is_game_over()) {
+            auto const playerIndex = state.get_controlling_player_index();
+            state.legal_actions(playerIndex, actions);
+            auto const choices = actions.size() > 1 ? actions.size() - 1 : actions.size();
+            before = state;
+            apply_input(state, playerIndex, actions[static_cast<int> (rng() % choices)]);
+        }
+
+        THEN("the game ends at the limit in favour of the richest player") {
+            REQUIRE(state.get_adjudication() == Adjudication::TurnLimit);
+            REQUIRE(state.get_turn() == setup.maxTurns);
+            auto const winner = state.get_winner_index();
+            REQUIRE(winner != Player::None);
+            for (auto p = 0; p < setup.playerCount; ++p) {
+                REQUIRE(state.get_player_eliminated(p) == (p != winner));
+                REQUIRE(before.get_net_worth(p) <= before.get_net_worth(winner));
+            }
+            REQUIRE(state.hash() == state.recompute_hash());
+        }
+        WHEN("the last action is undone") {
+            state.undo();
+            THEN("the game is no longer over") {
+                REQUIRE(state == before);
+                REQUIRE(state.get_adjudication() == Adjudication::None);
+                REQUIRE(state.hash() == before.hash());
+            }
+        }
+    }
+    GIVEN("Players with equal net worth") {
+        GameState fresh(setup);
+        WHEN("the game runs out of time") {
+            fresh.force_adjudicate(Adjudication::WallTime);
+            THEN("the earliest seat wins") {
+                REQUIRE(fresh.is_game_over());
+                REQUIRE(fresh.get_adjudication() == Adjudication::WallTime);
+                REQUIRE(fresh.get_winner_index() == Player::p1);
+            }
+        }
+    }
+}
@@ -20,7 +20,7 @@ namespace monopoly
             return setup;
         }
 
-        void update(GameState state) final {
+        void update(GameState const& state) final {
         }
     };
 }
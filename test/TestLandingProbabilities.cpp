@@ -0,0 +1,54 @@
+#include "Test.h"
+#include "LandingProbabilities.h"
+using namespace monopoly;
+
+#include "catch2/catch.hpp"
+
+#include <numeric>
+
+SCENARIO("Landing probabilities are solved from the movement rules", "[landing]") {
+    GIVEN("Players who roll to get out of jail") {
+        auto const& landing = LandingProbabilities::get(JailStrategy::Roll);
+        auto const& perRoll = landing.per_roll();
+
+        THEN("every roll ends somewhere") {
+            REQUIRE(std::accumulate(perRoll.begin(), perRoll.end(), 0.0) == Approx(1.0));
+        }
+        THEN("nobody stays on Go To Jail") {
+            REQUIRE(landing.per_roll(Space::GoToJail) == 0.0);
+        }
+        THEN("jail is the most likely space") {
+            REQUIRE(std::max_element(perRoll.begin(), perRoll.end()) - perRoll.begin() == space_to_index(Space::Jail));
+        }
+        THEN("spaces a roll or a card away from jail are landed on more often") {
+            REQUIRE(landing.per_roll(Space::Red_3) > landing.per_roll(Space::Blue_1));
+            REQUIRE(landing.per_roll(Space::Orange_3) > landing.per_roll(Space::LightBlue_1));
+        }
+        THEN("a turn has between one and two rolls") {
+            auto const& perTurn = landing.per_turn();
+            auto const rolls = std::accumulate(perTurn.begin(), perTurn.end(), 0.0);
+            REQUIRE(rolls > 1.0);
+            REQUIRE(rolls < 2.0);
+        }
+    }
+    GIVEN("Players who pay bail at once") {
+        THEN("they spend less time in jail") {
+            REQUIRE(LandingProbabilities::get(JailStrategy::PayBail).per_roll(Space::Jail)
+                < LandingProbabilities::get(JailStrategy::Roll).per_roll(Space::Jail));
+        }
+    }
+    GIVEN("A player starting a turn on Go") {
+        auto const& landing = LandingProbabilities::get();
+
+        THEN("their first turn can't end on the first space") {
+            auto const firstTurn = landing.horizon(Space::Go, 1);
+            REQUIRE(firstTurn[space_to_index(Space::Brown_1)] == 0.0);
+            REQUIRE(firstTurn[space_to_index(Space::Railroad_1)] > 0.0);
+        }
+        THEN("over many turns they land like any other player") {
+            auto const turns = 2000;
+            auto const landings = landing.horizon(Space::Go, turns);
+            REQUIRE(landings[space_to_index(Space::Red_3)] / turns == Approx(landing.per_turn(Space::Red_3)).epsilon(0.02));
+        }
+    }
+}
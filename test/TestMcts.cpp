@@ -0,0 +1,118 @@
+#include "Test.h"
+#include "Mcts.h"
+using namespace monopoly;
+
+#include "catch2/catch.hpp"
+
+SCENARIO("The MCTS bot only makes legal inputs and reports its playouts", "[mcts]") {
+    GameSetup setup;
+    setup.seed = "mcts";
+    setup.playerCount = 2;
+    GameState state(setup);
+    state.force_land(Player::p1, Space::Blue_2);
+
+    GIVEN("A search on a single thread") {
+        MctsOptions options;
+        options.iterations = 64;
+        options.rolloutTurns = 20;
+        options.solveShallowDecisions = false;
+        MctsSearch search(options);
+
+        WHEN("player 1 decides whether to buy the property they landed on") {
+            auto const input = search.search(state, Player::p1);
+
+            THEN("they choose one of the legal inputs") {
+                REQUIRE((std::holds_alternative<BuyPropertyInput>(input) || std::holds_alternative<AuctionPropertyInput>(input)));
+            }
+            THEN("every iteration played out a game") {
+                REQUIRE(search.get_stats().decisions == 1);
+                REQUIRE(search.get_stats().rollouts == options.iterations);
+            }
+            AND_WHEN("the same search is run again") {
+                MctsSearch repeat(options);
+
+                THEN("it makes the same choice") {
+                    REQUIRE(repeat.search(state, Player::p1).index() == input.index());
+                }
+            }
+        }
+        WHEN("the cards nobody has seen are in a different order") {
+            auto reordered = state;
+            for (auto deckType : { DeckType::Chance, DeckType::CommunityChest }) {
+                auto cards = state.get_deck(deckType).get_cards();
+                std::reverse(cards.begin(), cards.end());
+                reordered.force_stack_deck(deckType, cards);
+            }
+            REQUIRE(reordered != state);
+            auto const input = search.search(state, Player::p1);
+            MctsSearch other(options);
+
+            THEN("the search plays out exactly the same, since it can't see the upcoming cards") {
+                REQUIRE(other.search(reordered, Player::p1).index() == input.index());
+                REQUIRE(other.get_stats().rollouts == search.get_stats().rollouts);
+                REQUIRE(reordered.observed_hash() == state.observed_hash());
+            }
+        }
+        WHEN("player 1 has only one sensible input") {
+            GameState start(setup);
+            auto const input = search.search(start, Player::p1);
+
+            THEN("it is chosen without searching") {
+                REQUIRE(std::holds_alternative<RollInput>(input));
+                REQUIRE(search.get_stats().rollouts == 0);
+            }
+        }
+    }
+    GIVEN("A search that leaves shallow decisions to expectimax") {
+        MctsOptions options;
+        options.iterations = 64;
+        MctsSearch search(options);
+
+        WHEN("player 1 decides whether to buy the property they landed on") {
+            auto const input = search.search(state, Player::p1);
+
+            THEN("the decision is solved without playouts") {
+                REQUIRE((std::holds_alternative<BuyPropertyInput>(input) || std::holds_alternative<AuctionPropertyInput>(input)));
+                REQUIRE(search.get_stats().rollouts == 0);
+            }
+        }
+    }
+    GIVEN("Searches on a pool of threads") {
+        for (auto parallelism : { MctsParallelism::Tree, MctsParallelism::Root }) {
+            MctsOptions options;
+            options.iterations = 64;
+            options.rolloutTurns = 20;
+            options.threadCount = 3;
+            options.parallelism = parallelism;
+            options.solveShallowDecisions = false;
+            MctsSearch search(options);
+
+            auto const first = search.search(state, Player::p1);
+            auto const second = search.search(state, Player::p1);
+
+            THEN("the workers share the iteration budget") {
+                REQUIRE((std::holds_alternative<BuyPropertyInput>(first) || std::holds_alternative<AuctionPropertyInput>(first)));
+                REQUIRE((std::holds_alternative<BuyPropertyInput>(second) || std::holds_alternative<AuctionPropertyInput>(second)));
+                REQUIRE(search.get_stats().rollouts == 2 * options.iterations);
+            }
+        }
+    }
+}
+
+SCENARIO("The MCTS interface plays every seat of a game", "[mcts]") {
+    GameSetup setup;
+    setup.seed = "mcts interface";
+    setup.playerCount = 2;
+    MctsOptions options;
+    options.iterations = 16;
+    options.rolloutTurns = 10;
+    options.solveShallowDecisions = false;
+    MctsInterface interface(setup, options);
+    Game game(&interface);
+
+    while (game.get_state().get_turn() < 5) {
+        game.process();
+    }
+    REQUIRE(interface.get_stats().decisions > 0);
+    REQUIRE(interface.get_stats().rollouts > 0);
+}
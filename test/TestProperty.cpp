@@ -386,6 +386,30 @@ SCENARIO("Players must pay off mortgaged properties before they can improve prop
             }
         }
 
+        WHEN("player 2 lands on the mortgaged " + to_string(p1Property)) {
+            test.set_player_funds(Player::p2, startingFunds);
+            test.land_on_space(Player::p2, property_to_space(p1Property));
+
+            THEN("player 1 collects no rent") {
+                test.require_funds(Player::p1, startingFunds);
+                test.require_funds(Player::p2, startingFunds);
+            }
+        }
+        AND_GIVEN("player 1 has unmortgaged " + to_string(p1Property)) {
+            test.unmortgage_property(p1Property);
+            auto const fundsAfterUnmortgaging = test.game.get_state().get_player_funds(Player::p1);
+
+            WHEN("player 2 lands on " + to_string(p1Property)) {
+                test.set_player_funds(Player::p2, startingFunds);
+                test.land_on_space(Player::p2, property_to_space(p1Property));
+
+                THEN("player 2 pays double rent, since player 1 still owns the whole group") {
+                    auto const rent = 2 * rent_price_of_real_estate(p1Property);
+                    test.require_funds(Player::p1, fundsAfterUnmortgaging + rent);
+                    test.require_funds(Player::p2, startingFunds - rent);
+                }
+            }
+        }
         AND_GIVEN("player 1 doesn't have enough money to cover the mortgage") {
             test.set_player_funds(Player::p1, 0);
 
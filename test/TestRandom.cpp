@@ -0,0 +1,56 @@
+#include "Test.h"
+#include "Game.h"
+#include "Random.h"
+using namespace monopoly;
+
+#include "catch2/catch.hpp"
+
+SCENARIO("Games can use a small random number generator", "[random]") {
+    GIVEN("A Pcg32 seeded like the reference implementation") {
+        Pcg32 pcg(42, 54);
+
+        THEN("it produces the reference output") {
+            for (auto expected : { 0xa15c02b7u, 0x7b47f409u, 0xba1d3330u, 0x83d2f293u, 0xbfa4784bu, 0xcbed606eu }) {
+                REQUIRE(pcg() == expected);
+            }
+        }
+    }
+    GIVEN("Games seeded the same way with each kind of generator") {
+        for (auto kind : { RngKind::Mt19937, RngKind::Pcg32 }) {
+            GameSetup setup;
+            setup.seed = "random";
+            setup.rng = kind;
+            GameState state(setup);
+
+            THEN("they play out the same way every time") {
+                GameState same(setup);
+                REQUIRE(state == same);
+                for (auto roll = 0; roll < 20; ++roll) {
+                    REQUIRE(state.random_dice_roll() == same.random_dice_roll());
+                }
+                REQUIRE(state == same);
+            }
+            THEN("a copy keeps the generator, and drawing from the copy changes only the copy") {
+                auto copy = state;
+                REQUIRE(copy == state);
+                copy.random_dice_roll();
+                REQUIRE(copy != state);
+            }
+            THEN("undo restores the generator") {
+                state.set_journaling(true);
+                auto const before = state;
+                state.player_action_roll(Player::p1);
+                state.undo();
+                REQUIRE(state == before);
+            }
+        }
+    }
+    GIVEN("The two kinds of generator") {
+        THEN("the small one keeps its state in the game itself") {
+            REQUIRE(sizeof(Rng) <= 32);
+            REQUIRE(Rng(RngKind::Pcg32).get_kind() == RngKind::Pcg32);
+            REQUIRE(Rng(RngKind::Mt19937).get_kind() == RngKind::Mt19937);
+            REQUIRE(Rng(RngKind::Pcg32) != Rng(RngKind::Mt19937));
+        }
+    }
+}
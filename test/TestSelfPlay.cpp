@@ -0,0 +1,146 @@
+#include "Test.h"
+#include "Game.h"
+#include "Policies.h"
+#include "SelfPlay.h"
+using namespace monopoly;
+
+#include "catch2/catch.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <set>
+
+namespace
+{
+    std::vector<TrainingRecord> record_game(std::string const& seed, int gameIndex, int maxCycles) {
+        GameSetup setup;
+        setup.seed = seed;
+        setup.playerCount = 3;
+        GameRecorder recorder(gameIndex);
+        std::vector<std::unique_ptr<IPolicy>> policies;
+        for (auto seat = 0; seat < setup.playerCount; ++seat) {
+            policies.push_back(std::make_unique<RecordingPolicy>(std::make_unique<RandomPolicy>(seat), recorder));
+        }
+        BotInterface interface(setup, std::move(policies));
+        Game game(&interface);
+        for (auto cycle = 0; cycle < maxCycles && !game.get_state().is_game_over(); ++cycle) {
+            game.process();
+        }
+        recorder.finish(game.get_state());
+        return recorder.take();
+    }
+
+    bool same_records(std::vector<TrainingRecord> const& a, std::vector<TrainingRecord> const& b) {
+        return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(TrainingRecord)) == 0;
+    }
+}
+
+SCENARIO("Legal actions are numbered for training data", "[selfplay]") {
+    GIVEN("A game played with random inputs") {
+        GameSetup setup;
+        setup.seed = "actions";
+        setup.playerCount = 3;
+        GameState state(setup);
+        RandomPolicy policy(7);
+        ActionBuffer actions;
+        std::array<uint64_t, ActionLayout::MaskWords> mask;
+
+        THEN("every legal action has its own index, and the mask holds exactly those") {
+            for (auto step = 0; step < 2000 && !state.is_game_over(); ++step) {
+                auto const playerIndex = state.get_controlling_player_index();
+                legal_action_mask(state, playerIndex, actions, mask);
+                std::set<int> indices;
+                for (auto const& input : actions) {
+                    auto const index = action_index(state, playerIndex, input);
+                    REQUIRE(0 <= index);
+                    REQUIRE(index < ActionLayout::Count);
+                    REQUIRE((mask[index / 64] >> (index % 64) & 1) == 1);
+                    indices.insert(index);
+                }
+                REQUIRE(static_cast<int> (indices.size()) == actions.size());
+                auto bits = 0;
+                for (auto word : mask) {
+                    for (; word; word &= word - 1) {
+                        ++bits;
+                    }
+                }
+                REQUIRE(bits == actions.size());
+                apply_input(state, playerIndex, policy.decide(state, playerIndex));
+            }
+        }
+    }
+    GIVEN("An auction") {
+        GameSetup setup;
+        setup.seed = "actions";
+        setup.playerCount = 2;
+        GameState state(setup);
+        state.force_land(Player::p1, Space::Blue_2);
+        state.player_action_auction_property(Player::p1);
+        auto const playerIndex = state.get_controlling_player_index();
+        auto const highestBid = state.get_current_auction().highestBid;
+
+        THEN("bids are bucketed by how far they raise the highest bid") {
+            REQUIRE(action_index(state, playerIndex, BidInput{ highestBid + 1 }) == ActionLayout::Bid);
+            REQUIRE(action_index(state, playerIndex, BidInput{ highestBid + 30 }) == ActionLayout::Bid + 1);
+            REQUIRE(action_index(state, playerIndex, BidInput{ highestBid + 1000 }) == ActionLayout::Bid + ActionLayout::BidBuckets - 1);
+            REQUIRE(action_index(state, playerIndex, BidInput{ highestBid }) == -1);
+        }
+    }
+}
+
+SCENARIO("Self-play games are recorded to shards", "[selfplay]") {
+    GIVEN("The same seed") {
+        THEN("a game is recorded the same way every time") {
+            auto const first = record_game("selfplay", 0, 300);
+            REQUIRE(!first.empty());
+            REQUIRE(same_records(first, record_game("selfplay", 0, 300)));
+            for (auto const& record : first) {
+                REQUIRE(record.outcome == 0);
+                REQUIRE((record.legalActions[record.action / 64] >> (record.action % 64) & 1) == 1);
+            }
+        }
+    }
+    GIVEN("A shard of every other game, submitted out of order") {
+        auto const path = std::string("TestSelfPlay.shard");
+        std::vector<std::vector<TrainingRecord>> games;
+        for (auto gameIndex = 0; gameIndex < 6; ++gameIndex) {
+            games.push_back(record_game("shard", gameIndex, 50 + 20 * gameIndex));
+        }
+        {
+            ShardWriter writer(path, 0, 2, 6);
+            writer.submit(4, games[4]);
+            writer.submit(0, games[0]);
+            writer.submit(2, games[2]);
+            writer.finish();
+            REQUIRE(writer.get_record_count() == games[0].size() + games[2].size() + games[4].size());
+        }
+
+        THEN("the file holds the games in order behind an index") {
+            std::ifstream file(path, std::ios::binary);
+            ShardHeader header;
+            file.read(reinterpret_cast<char*> (&header), sizeof(header));
+            REQUIRE(std::memcmp(header.magic, ShardHeader::MagicValue, sizeof(header.magic)) == 0);
+            REQUIRE(header.recordSize == sizeof(TrainingRecord));
+            REQUIRE(header.featureStride == FeatureLayout::Stride);
+            REQUIRE(header.actionCount == ActionLayout::Count);
+            REQUIRE(header.gameCount == 3);
+            REQUIRE(header.recordCount == games[0].size() + games[2].size() + games[4].size());
+
+            file.seekg(header.indexOffset);
+            std::vector<ShardIndexEntry> index(header.gameCount);
+            file.read(reinterpret_cast<char*> (index.data()), index.size() * sizeof(ShardIndexEntry));
+            for (auto i = 0; i < 3; ++i) {
+                auto const& game = games[2 * i];
+                REQUIRE(index[i].gameIndex == static_cast<uint32_t> (2 * i));
+                REQUIRE(index[i].recordCount == game.size());
+
+                std::vector<TrainingRecord> records(game.size());
+                file.seekg(sizeof(ShardHeader) + index[i].firstRecord * sizeof(TrainingRecord));
+                file.read(reinterpret_cast<char*> (records.data()), records.size() * sizeof(TrainingRecord));
+                REQUIRE(same_records(records, game));
+            }
+        }
+        std::remove(path.c_str());
+    }
+}
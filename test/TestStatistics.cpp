@@ -0,0 +1,100 @@
+#include "Test.h"
+#include "Game.h"
+#include "Policies.h"
+#include "Statistics.h"
+using namespace monopoly;
+
+#include "catch2/catch.hpp"
+
+#include <sstream>
+
+namespace
+{
+    void play(std::string const& seed, GameStatistics& statistics) {
+        StatisticsSink sink(statistics);
+        GameSetup setup;
+        setup.seed = seed;
+        setup.playerCount = 3;
+        setup.eventSink = &sink;
+        std::vector<std::unique_ptr<IPolicy>> policies;
+        for (auto seat = 0; seat < setup.playerCount; ++seat) {
+            policies.push_back(std::make_unique<GreedyPolicy>());
+        }
+        BotInterface interface(setup, std::move(policies));
+        Game game(&interface);
+        auto const& state = game.get_state();
+        while (!state.is_game_over() && state.get_turn() < 500) {
+            game.process();
+        }
+        sink.finish_game(state);
+    }
+}
+
+SCENARIO("Statistics are collected from game events", "[statistics]") {
+    GIVEN("A player who lands on an owned property") {
+        GameStatistics statistics;
+        StatisticsSink sink(statistics);
+        GameSetup setup;
+        setup.seed = "statistics";
+        setup.playerCount = 2;
+        setup.eventSink = &sink;
+        GameState state(setup);
+        state.force_give_deeds(Player::p2, { Property::Blue_1, Property::Blue_2 });
+        state.force_funds(Player::p1, 10);
+        state.force_land(Player::p1, Space::Blue_2);
+
+        THEN("the rent is counted against the property and its group") {
+            REQUIRE(statistics.landingsByProperty[static_cast<int> (Property::Blue_2)] == 1);
+            REQUIRE(statistics.rentByProperty[static_cast<int> (Property::Blue_2)] == 100);
+            REQUIRE(statistics.rent_by_group(PropertyGroup::Blue) == 100);
+        }
+        WHEN("they resign over the rent") {
+            state.player_action_resign(Player::p1);
+
+            THEN("the bankruptcy is put down to rent") {
+                REQUIRE(statistics.bankruptcies[static_cast<int> (BankruptcyCause::Rent)] == 1);
+            }
+        }
+    }
+    GIVEN("Games collected on separate accumulators") {
+        GameStatistics first;
+        GameStatistics second;
+        GameStatistics both;
+        play("statistics:0", first);
+        play("statistics:1", second);
+        play("statistics:0", both);
+        play("statistics:1", both);
+
+        THEN("merging them gives the same totals as collecting them together") {
+            first.merge(second);
+            REQUIRE(first.to_json() == both.to_json());
+            REQUIRE(first.games == 2);
+        }
+        THEN("every game is counted once in the length histogram and by seat") {
+            auto counted = 0ll;
+            for (auto count : both.gameLengths) {
+                counted += count;
+            }
+            REQUIRE(counted == both.games);
+            REQUIRE(both.gamesBySeat[0] == 2);
+            REQUIRE(both.gamesBySeat[3] == 0);
+        }
+        THEN("the table and json reports are written") {
+            std::ostringstream table;
+            both.write_table(table);
+            REQUIRE(table.str().find("bankruptcy cause") != std::string::npos);
+            REQUIRE(both.to_json().find("\"returnOnInvestment\"") != std::string::npos);
+        }
+        THEN("they can be saved and read back exactly") {
+            std::stringstream saved;
+            both.write(saved);
+            GameStatistics restored;
+            restored.read(saved);
+            REQUIRE(restored.to_json() == both.to_json());
+            REQUIRE(restored.gameLengths == both.gameLengths);
+
+            std::stringstream truncated(saved.str().substr(0, 40));
+            REQUIRE_THROWS_AS(GameStatistics().read(truncated), std::runtime_error);
+        }
+    }
+}
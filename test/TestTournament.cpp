@@ -0,0 +1,125 @@
+#include "Test.h"
+#include "Tournament.h"
+using namespace monopoly;
+
+#include "catch2/catch.hpp"
+
+#include <atomic>
+#include <set>
+
+namespace
+{
+    bool same_games(TournamentResults const& lhs, TournamentResults const& rhs) {
+        if (lhs.games.size() != rhs.games.size()) {
+            return false;
+        }
+        for (auto i = 0u; i < lhs.games.size(); ++i) {
+            auto const& a = lhs.games[i];
+            auto const& b = rhs.games[i];
+            if (a.gameIndex != b.gameIndex || a.entrants[0] != b.entrants[0] || a.entrants[1] != b.entrants[1]
+                || a.winner != b.winner || a.turns != b.turns) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+SCENARIO("Work stealing runs every task once", "[tournament]") {
+    GIVEN("Tasks of very different lengths") {
+        auto const taskCount = 200;
+        std::vector<std::atomic<int>> runs(taskCount);
+
+        THEN("each task runs exactly once on any number of threads") {
+            for (auto threadCount : { 1, 3, 8 }) {
+                for (auto& r : runs) {
+                    r = 0;
+                }
+                run_work_stealing(taskCount, threadCount, [&runs](int i) {
+                    // The last tasks of each block take longest, so the other threads have to steal them
+                    volatile auto sink = 0;
+                    for (auto k = 0; k < (i % 25) * 2000; ++k) {
+                        sink = sink + k;
+                    }
+                    runs[i] += 1;
+                });
+                for (auto const& r : runs) {
+                    REQUIRE(r == 1);
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("Tournaments between bot policies", "[tournament]") {
+    TournamentOptions options;
+    options.seed = "league";
+    options.maxTurns = 150;
+    std::vector<std::string> const entrants = { "greedy", "random", "random", "greedy" };
+
+    GIVEN("A round robin") {
+        options.format = TournamentFormat::RoundRobin;
+        options.gamesPerPairing = 2;
+        Tournament const tournament(entrants, options);
+        auto const results = tournament.run();
+
+        THEN("every pairing plays its games with each entrant taking the first seat once") {
+            REQUIRE(results.games.size() == 6 * 2);
+            for (auto i = 0u; i < results.games.size(); i += 2) {
+                REQUIRE(results.games[i].entrants[0] == results.games[i + 1].entrants[1]);
+                REQUIRE(results.games[i].entrants[1] == results.games[i + 1].entrants[0]);
+            }
+        }
+        THEN("the standings account for every game") {
+            auto halfPoints = 0;
+            for (auto const& standing : results.standings) {
+                halfPoints += standing.halfPoints;
+                REQUIRE(standing.wins + standing.draws + standing.losses == 3 * 2);
+            }
+            REQUIRE(halfPoints == 2 * static_cast<int> (results.games.size()));
+            for (auto i = 1u; i < results.standings.size(); ++i) {
+                REQUIRE(results.standings[i - 1].halfPoints >= results.standings[i].halfPoints);
+            }
+        }
+        THEN("the results are the same on more threads") {
+            auto threaded = options;
+            threaded.threadCount = 4;
+            REQUIRE(same_games(results, Tournament(entrants, threaded).run()));
+        }
+    }
+    GIVEN("A swiss tournament with an odd number of entrants") {
+        options.format = TournamentFormat::Swiss;
+        options.gamesPerPairing = 1;
+        options.swissRounds = 3;
+        std::vector<std::string> const oddEntrants = { "greedy", "random", "random", "greedy", "random" };
+        Tournament const tournament(oddEntrants, options);
+        auto const results = tournament.run();
+
+        THEN("each round pairs everyone but one entrant, who gets a bye") {
+            auto halfPoints = 0;
+            for (auto const& standing : results.standings) {
+                halfPoints += standing.halfPoints;
+            }
+            REQUIRE(halfPoints == 2 * (static_cast<int> (results.games.size()) + 3));
+            REQUIRE(results.games.size() == 3 * 2);
+            auto byes = 0;
+            for (auto const& standing : results.standings) {
+                byes += standing.byes;
+                REQUIRE(standing.byes <= 1);
+            }
+            REQUIRE(byes == 3);
+        }
+        THEN("nobody plays the same opponent twice") {
+            std::set<std::pair<int, int>> pairings;
+            for (auto const& game : results.games) {
+                auto const pairing = std::minmax(game.entrants[0], game.entrants[1]);
+                REQUIRE(pairings.insert(pairing).second);
+            }
+        }
+        THEN("the results are the same on more threads") {
+            auto threaded = options;
+            threaded.threadCount = 4;
+            REQUIRE(same_games(results, Tournament(oddEntrants, threaded).run()));
+        }
+    }
+}
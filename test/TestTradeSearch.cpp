@@ -0,0 +1,85 @@
+#include "Test.h"
+#include "TradeSearch.h"
+using namespace monopoly;
+
+#include "catch2/catch.hpp"
+
+SCENARIO("Trade search finds trades that help both players", "[trade]") {
+    GameSetup setup;
+    setup.seed = "tradesearch";
+    setup.playerCount = 2;
+    GameState state(setup);
+
+    GIVEN("Each player holds the last property of a group the other player is building") {
+        state.force_give_deeds(Player::p1, { Property::Red_1, Property::Red_2, Property::Orange_1 });
+        state.force_give_deeds(Player::p2, { Property::Red_3, Property::Orange_2, Property::Orange_3 });
+
+        THEN("the best trade completes a group for both of them") {
+            TradeSearch const search;
+            auto const trades = search.search(state, Player::p1, Player::p2);
+            REQUIRE_FALSE(trades.empty());
+            auto const& best = trades.front();
+            auto const p1After = (state.get_player_deeds(Player::p1) - best.trade.offer.deeds) | best.trade.consideration.deeds;
+            auto const p2After = (state.get_player_deeds(Player::p2) - best.trade.consideration.deeds) | best.trade.offer.deeds;
+            REQUIRE((p1After.contains_all(properties_in_group(PropertyGroup::Red)) || p1After.contains_all(properties_in_group(PropertyGroup::Orange))));
+            REQUIRE((p2After.contains_all(properties_in_group(PropertyGroup::Red)) || p2After.contains_all(properties_in_group(PropertyGroup::Orange))));
+            REQUIRE(best.offeringGain > 0);
+            REQUIRE(best.consideringGain > 0);
+            REQUIRE(state.check_if_trade_is_valid(best.trade));
+        }
+        THEN("every trade found can be made") {
+            TradeSearchOptions options;
+            options.topK = 100;
+            for (auto const& scored : TradeSearch(options).search(state, Player::p1)) {
+                REQUIRE(state.check_if_trade_is_valid(scored.trade));
+                REQUIRE(scored.offeringGain > 0);
+                REQUIRE(scored.consideringGain > 0);
+            }
+        }
+        THEN("searching with several threads finds the same trades") {
+            TradeSearchOptions options;
+            options.topK = 100;
+            auto const single = TradeSearch(options).search(state, Player::p1, Player::p2);
+            options.threadCount = 2;
+            auto const threaded = TradeSearch(options).search(state, Player::p1, Player::p2);
+            REQUIRE(single.size() == threaded.size());
+            for (auto i = 0u; i < single.size(); ++i) {
+                REQUIRE(std::min(single[i].offeringGain, single[i].consideringGain)
+                    == std::min(threaded[i].offeringGain, threaded[i].consideringGain));
+            }
+        }
+        THEN("trades with equal scores are kept in the same order by any number of threads") {
+            TradeSearchOptions options;
+            options.topK = 3;
+            auto const single = TradeSearch(options).search(state, Player::p1, Player::p2);
+            for (auto threadCount = 2; threadCount <= 4; ++threadCount) {
+                options.threadCount = threadCount;
+                auto const threaded = TradeSearch(options).search(state, Player::p1, Player::p2);
+                REQUIRE(threaded.size() == single.size());
+                for (auto i = 0u; i < single.size(); ++i) {
+                    REQUIRE(threaded[i].trade == single[i].trade);
+                }
+            }
+        }
+    }
+    GIVEN("The players hold nothing the other player wants") {
+        state.force_give_deeds(Player::p1, { Property::Red_1, Property::Red_2 });
+        state.force_give_deeds(Player::p2, { Property::Orange_2, Property::Orange_3 });
+
+        THEN("no trades are found") {
+            REQUIRE(TradeSearch().search(state, Player::p1).empty());
+        }
+    }
+    GIVEN("The other player can't pay what the trade is worth") {
+        state.force_give_deeds(Player::p1, { Property::Blue_1 });
+        state.force_give_deeds(Player::p2, { Property::Blue_2 });
+        state.force_funds(Player::p2, 0);
+
+        THEN("no trade asks for more cash than they have") {
+            for (auto const& scored : TradeSearch().search(state, Player::p1, Player::p2)) {
+                REQUIRE(scored.trade.consideration.cash == 0);
+                REQUIRE(state.check_if_trade_is_valid(scored.trade));
+            }
+        }
+    }
+}